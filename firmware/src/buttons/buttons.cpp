@@ -1,5 +1,6 @@
 #include "buttons.h"
 #include "filter_handler/filter_handler.h"
+#include "power_state/power_state.h"
 #include "logging.h"
 #include "gpio.h"
 #include "globals.h"
@@ -21,12 +22,10 @@ void mode_button_irq_function() {
  * @brief Power button IRQ function.
  *
  * This function is triggered by an interrupt from the power button.
- * It is intended to turn the device on and off.
- * Note: The implementation details for turning off are pending.
+ * It turns the device on and off, the main loop does the switching.
  */
 void power_button_irq_function() {
-    LOG_DEBUG("POWER BUTTON FIRE");
-    flag_toggle_system_power = true;  // Flag variable to signal events
+    power_button_pressed();  // Debounces, flags the main loop and wakes it from the off state
 }
 
 /**
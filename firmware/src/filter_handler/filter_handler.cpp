@@ -5,49 +5,196 @@
  * Contains functionality for changing the state of the device,
  * including switching types of LED filters (the pattern of the LEDs)
  * and handling an off mode.
+ *
+ * The filters are listed in filter_registry.h. A filter is only constructed
+ * while it renders, in one of two slots that every filter type shares, so
+ * it starts over each time its mode comes up and filters that do not run
+ * at the same time share their storage. The filter calls are dispatched
+ * by a switch over the registered types and inline into the frame loop.
+ *
+ * A mode change does not cut over from one frame to the next. For
+ * FILTER_TRANSITION_FRAMES frames both the outgoing and the incoming
+ * filter render, the outgoing one into a frame of its own, and the two
+ * are crossfaded into the driver's frame.
  */
 
 #pragma once
+#include <variant>
+#include <type_traits>
 #include "logging.h"
 #include "filter_handler.h"
 #include "globals.h"
 #include "led_filters/LEDFilter.h"
-#include "led_filters/LEDFilter_Basic.cpp"
-#include "led_filters/LEDFilter_Smooth.cpp"
-#include "led_filters/LEDFilter_Wave.cpp"
-#include "led_filters/LEDFilter_BikeWheel.cpp"
+#include "led_filters/LEDFilter_Basic.h"
+#include "led_filters/LEDFilter_Smooth.h"
+#include "led_filters/LEDFilter_Wave.h"
+#include "led_filters/LEDFilter_BikeWheel.h"
+#include "led_filters/LEDFilter_Composite.h"
+#include "led_filters/LEDFilter_POV.h"
 
 
 LOG_MODULE(STATE_HANDLER)
 
-// Instances of LED filter objects
-LEDFilter_Smooth led_filter_smooth(FILTER_STAR_FREQUENCY_FACTOR, FILTER_STAR_FADE_SPEED);
-LEDFilter_Basic led_filter_basic;
-LEDFilter_Wave led_filter_wave(FILTER_WAVE_SMOOTHING,
-                               FILTER_WAVE_FREQUENCY,
-                               FILTER_WAVE_AMPLITUDE);
-LEDFilter_BicycleWheel led_filter_bike_wheel;
+// Layers of MODE_LAYERED, bottom first: a wave with the bike wheel pattern screened over it as the gyro picks up
+static constexpr CompositeLayer layered_stack[] = {
+        {BLEND_MODE_ALPHA, LAYER_OPACITY_FIXED, 255, 255},
+        {BLEND_MODE_SCREEN, LAYER_OPACITY_GYRO, 0, 255},
+};
+using LEDFilter_Layered = LEDFilter_Composite<layered_stack, LEDFilter_Wave, LEDFilter_BicycleWheel>;
+
+
+#define LED_FILTER_TYPE(mode, name, type) , type
+#define LED_FILTER_NAME(mode, name, type) #name,
+#define LED_FILTER_EMPLACE(mode, name, type) case mode: slot.emplace<type>(); break;
+#define LED_FILTER_VISIT(mode, name, type) case mode + 1: visitor(*std::get_if<type>(&slot)); break;
+
+// Storage for any one registered filter, empty while no filter uses it
+using LEDFilterSlot = std::variant<std::monostate LED_FILTERS(LED_FILTER_TYPE)>;
+
+static const char *const led_filter_names[MODE_MAX_VALUE] = {LED_FILTERS(LED_FILTER_NAME)};
+
+/* Constructs the filter of a state in a slot, the filter that was there is destroyed. */
+static void emplace_led_filter(LEDFilterSlot &slot, AppState state) {
+    switch (state) {
+        LED_FILTERS(LED_FILTER_EMPLACE)
+        default:
+            slot.emplace<std::monostate>();
+            break;
+    }
+}
+
+/* Calls visitor with the filter in a slot as its own type, nothing happens for an empty slot. */
+template <typename Visitor>
+static inline void visit_led_filter(LEDFilterSlot &slot, Visitor &&visitor) {
+    switch (slot.index()) {
+        LED_FILTERS(LED_FILTER_VISIT)
+        default:
+            break;
+    }
+}
+
+#undef LED_FILTER_TYPE
+#undef LED_FILTER_NAME
+#undef LED_FILTER_EMPLACE
+#undef LED_FILTER_VISIT
+
 
 // Global variable to keep track of the current state
 volatile AppState current_state = MODE_BASIC;
 
-// Array of LED filter objects corresponding to each state
-LEDFilter* led_filters[MODE_MAX_VALUE] = {
-        &led_filter_basic,
-        &led_filter_smooth,
-        &led_filter_wave,
-        &led_filter_bike_wheel,
-};
+// State that is rendered, it follows current_state at the next frame
+static AppState shown_state = MODE_MAX_VALUE;
+
+// The filter of shown_state is in led_filter_slots[shown_slot], during a crossfade the other slot holds the outgoing filter
+static LEDFilterSlot led_filter_slots[2];
+static int shown_slot = 0;
+static int transition_frame = FILTER_TRANSITION_FRAMES;
+static uint8_t outgoing_pixels[NUM_PIXELS * PIXEL_FORMAT_BYTES(LED_STRIP_PIXEL_FORMAT)];
 
 /**
  * @brief Cycles to the next state in the sequence.
- *        Wraps around to MODE_BASIC after MODE_OFF.
+ *        Wraps around to MODE_BASIC after the last registered filter.
  */
 void increment_state() {
     current_state = static_cast<AppState>((current_state + 1) % MODE_MAX_VALUE);
 }
 
 
-void call_current_led_filter() {
-    led_filters[current_state]->apply_filter();
+const char *led_filter_name(AppState state) {
+    return state >= 0 && state < MODE_MAX_VALUE ? led_filter_names[state] : "none";
+}
+
+
+static inline bool in_transition() {
+    return transition_frame < FILTER_TRANSITION_FRAMES;
+}
+
+
+void set_led_filter_quality(int level) {
+    auto set_quality = [level](auto &filter) { led_filter_set_quality(filter, level); };
+
+    visit_led_filter(led_filter_slots[shown_slot], set_quality);
+    if (in_transition()) {
+        visit_led_filter(led_filter_slots[shown_slot ^ 1], set_quality);
+    }
+}
+
+
+/**
+ * @brief Starts a crossfade when the button changed the state since the last frame.
+ *
+ * The incoming filter is constructed in the slot that is not shown. A change
+ * during a crossfade fades from the filter that was fading in, the one that was
+ * fading out is dropped. The first frame after boot starts without a crossfade.
+ */
+static void start_transition() {
+    AppState requested = current_state;
+    if (requested == shown_state) {
+        return;
+    }
+
+    bool first = shown_state == MODE_MAX_VALUE;
+    int quality = 0;
+    visit_led_filter(led_filter_slots[shown_slot], [&quality](auto &filter) { quality = filter.get_quality(); });
+
+    if (!first && FILTER_TRANSITION_FRAMES > 0) {
+        shown_slot ^= 1;
+        transition_frame = 0;
+    }
+    emplace_led_filter(led_filter_slots[shown_slot], requested);
+    visit_led_filter(led_filter_slots[shown_slot], [quality](auto &filter) { led_filter_set_quality(filter, quality); });
+    shown_state = requested;
+}
+
+
+void call_current_led_filter(FrameBuffer *frame) {
+    start_transition();
+
+    auto render = [frame](auto &filter) { filter.apply_filter(frame); };
+
+    if (!in_transition()) {
+        visit_led_filter(led_filter_slots[shown_slot], render);
+        return;
+    }
+
+    FrameBuffer outgoing_frame = *frame;
+    outgoing_frame.pixels = outgoing_pixels;
+    visit_led_filter(led_filter_slots[shown_slot ^ 1], [&outgoing_frame](auto &filter) { filter.apply_filter(&outgoing_frame); });
+    visit_led_filter(led_filter_slots[shown_slot], render);
+
+    transition_frame++;
+    frame_buffer_blend(frame, &outgoing_frame, (uint32_t) ((transition_frame * 256) / (FILTER_TRANSITION_FRAMES + 1)));
+
+    if (!in_transition()) {
+        led_filter_slots[shown_slot ^ 1].emplace<std::monostate>();
+    }
+}
+
+
+int current_led_filter_subframes() {
+    int subframes = 0;
+    visit_led_filter(led_filter_slots[shown_slot], [&subframes](auto &filter) {
+        subframes = std::decay_t<decltype(filter)>::SUBFRAMES;
+    });
+    return subframes;
+}
+
+
+/**
+ * @brief Renders the shown filter into frame between two frames, if it renders in
+ * subframes. Crossfades only advance once per frame, so during one the subframes
+ * are left to the dithering.
+ */
+bool call_current_led_filter_subframe(FrameBuffer *frame) {
+    bool rendered = false;
+
+    if (!in_transition()) {
+        visit_led_filter(led_filter_slots[shown_slot], [frame, &rendered](auto &filter) {
+            if constexpr (std::decay_t<decltype(filter)>::SUBFRAMES > 0) {
+                filter.apply_filter(frame);
+                rendered = true;
+            }
+        });
+    }
+    return rendered;
 }
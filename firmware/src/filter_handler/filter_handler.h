@@ -1,16 +1,24 @@
 #pragma once
 
-// Enum to define different application states.
+#include "ws2812b/frame_buffer.h"
+#include "filter_registry.h"
+
+#define LED_FILTER_ENUM(mode, name, type) mode,
+
+// Enum to define different application states, one per filter in filter_registry.h.
 typedef enum {
-    MODE_BASIC,
-    MODE_SMOOTH,
-    MODE_NICE,
-    MODE_BIKE_WHEEL,
+    LED_FILTERS(LED_FILTER_ENUM)
     MODE_MAX_VALUE
 } AppState;
 
+#undef LED_FILTER_ENUM
+
 // Function declarations
 extern volatile AppState current_state;    // Current state of the application
 
 void increment_state();                    // Function to cycle to the next state
-void call_current_led_filter();            // Function to call the LED filter for the current state
\ No newline at end of file
+const char *led_filter_name(AppState state); // Function to get the registered name of a state's LED filter
+void set_led_filter_quality(int level);    // Function to set the quality level of the current state's LED filter
+void call_current_led_filter(FrameBuffer *frame); // Function to render the current state's LED filter into frame
+int current_led_filter_subframes();        // Function to get the slots per frame the shown LED filter renders in, 0 for once per frame
+bool call_current_led_filter_subframe(FrameBuffer *frame); // Function to render a subframe, false if the shown LED filter has none
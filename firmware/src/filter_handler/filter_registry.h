@@ -0,0 +1,20 @@
+/*
+ * File: filter_registry.h
+ * Description: The list of LED filters, one line per filter.
+ *
+ * LED_FILTERS(FILTER) calls FILTER(mode, name, type) for every filter in the
+ * order the mode button cycles through them. The AppState enum, the name table,
+ * the filter storage and the dispatch of filter_handler.cpp are all generated from
+ * it, so registering a filter is one line here. The type only has to be known
+ * where the storage is generated, in filter_handler.cpp, and needs a default
+ * constructor.
+ */
+#pragma once
+
+#define LED_FILTERS(FILTER)                                     \
+    FILTER(MODE_BASIC,      basic,      LEDFilter_Basic)        \
+    FILTER(MODE_SMOOTH,     smooth,     LEDFilter_Smooth)       \
+    FILTER(MODE_NICE,       wave,       LEDFilter_Wave)         \
+    FILTER(MODE_BIKE_WHEEL, bike_wheel, LEDFilter_BicycleWheel) \
+    FILTER(MODE_LAYERED,    layered,    LEDFilter_Layered)      \
+    FILTER(MODE_POV,        pov,        LEDFilter_POV)
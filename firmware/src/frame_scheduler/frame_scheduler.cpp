@@ -0,0 +1,220 @@
+/*
+ * File: frame_scheduler.cpp
+ * Description:
+ * Paces the main loop with osDelayUntil(). A frame period rarely is a whole
+ * number of kernel ticks (60 fps is 16.67 ms), so the deadlines are kept in Q16
+ * ticks and the fraction carries over from slot to slot. Over a second the frame
+ * rate is exact, each single slot is off by less than a tick.
+ *
+ * The work of a render slot is timed with the system timer, which runs much
+ * faster than the kernel tick. A frame misses its deadline when that work takes
+ * longer than its slot, since the subframe slot after it is due then. With one
+ * slot per frame that is the frame period. After FRAME_QUALITY_DOWN_MISSES misses within
+ * FRAME_QUALITY_WINDOW_FRAMES frames the quality level goes down one step, and it
+ * only comes back up after FRAME_QUALITY_UP_WINDOWS windows without a miss, so the
+ * level does not flip back and forth at the edge of the budget.
+ */
+
+#include "frame_scheduler.h"
+#include "kernel.h"
+#include "logging.h"
+#include "globals.h"
+
+LOG_MODULE(frame_scheduler)
+
+static uint64_t g_next_slot_q16;    // start of the next slot in Q16 ticks, only the low 32 bits of the tick count matter
+static uint32_t g_slot_period_q16;  // length of one slot in Q16 ticks
+static uint32_t g_frames_per_second;
+static int g_subframes = 1;
+static int g_next_subframes = 1;    // slots per frame from the next render slot on
+static int g_slot = 0;
+static uint32_t g_window_start;
+static uint32_t g_window_frames;
+static uint32_t g_slot_period_sys;      // one slot in system timer counts, the deadline of a render
+static uint32_t g_render_start_sys;     // system timer count when the last render slot started
+static bool g_render_pending = false;   // the last slot was a render slot whose work is not timed yet
+static int g_quality_frames;            // frames in the current quality window
+static int g_quality_misses;            // deadline misses in the current quality window
+static int g_quality_clean_windows;     // windows in a row without a miss
+static struct frame_scheduler_stats g_stats;
+
+
+/* The frame loop only waits in osDelayUntil(), so the kernel may always sleep when it is idle. */
+static int frame_scheduler_enter_sleep() {
+    return 1;
+}
+
+static void frame_scheduler_exit_sleep() {
+}
+
+
+int frame_scheduler_init(uint32_t frames_per_second, int subframes) {
+    if (frames_per_second == 0 || subframes < 1) {
+        LOG_ERROR("Invalid frame rate %lu fps with %d subframes.", (unsigned long) frames_per_second, subframes);
+        return -1;
+    }
+
+    g_subframes = subframes;
+    g_next_subframes = subframes;
+    frame_scheduler_set_rate(frames_per_second);
+
+    uint32_t now = osKernelGetTickCount();
+    g_next_slot_q16 = (uint64_t) now << 16;
+    g_window_start = now;
+
+    osKernelEnableIdleSleep(frame_scheduler_enter_sleep, frame_scheduler_exit_sleep);
+    return 0;
+}
+
+
+void frame_scheduler_set_rate(uint32_t frames_per_second) {
+    if (frames_per_second > 0) {
+        g_frames_per_second = frames_per_second;
+        g_slot_period_q16 = (uint32_t) (((uint64_t) osKernelGetTickFreq() << 16) / (frames_per_second * g_subframes));
+        g_slot_period_sys = osKernelGetSysTimerFreq() / (frames_per_second * g_subframes);
+    }
+}
+
+
+/**
+ * @brief Changes the number of slots per frame, keeping the frame rate.
+ *
+ * The change takes effect with the next render slot. The frame that is running
+ * keeps its slots, so a change never adds a render slot or moves the next one.
+ */
+void frame_scheduler_set_subframes(int subframes) {
+    if (subframes >= 1) {
+        g_next_subframes = subframes;
+    }
+}
+
+
+/********************************************//**
+ *  Steps the quality level down under sustained
+ *  deadline misses and back up, with hysteresis,
+ *  once frames fit again.
+ ***********************************************/
+static void frame_scheduler_adapt_quality(bool missed) {
+    g_quality_frames++;
+    g_quality_misses += missed ? 1 : 0;
+
+    if (g_quality_misses >= FRAME_QUALITY_DOWN_MISSES) {
+        if (g_stats.quality < FRAME_QUALITY_LEVELS - 1) {
+            g_stats.quality++;
+            LOG_DEBUG("Frames run late, quality level %d.", g_stats.quality);
+        }
+        g_quality_clean_windows = 0;
+    } else if (g_quality_frames < FRAME_QUALITY_WINDOW_FRAMES) {
+        return;
+    } else if (g_quality_misses == 0 && ++g_quality_clean_windows >= FRAME_QUALITY_UP_WINDOWS) {
+        if (g_stats.quality > 0) {
+            g_stats.quality--;
+            LOG_DEBUG("Frames fit again, quality level %d.", g_stats.quality);
+        }
+        g_quality_clean_windows = 0;
+    } else if (g_quality_misses > 0) {
+        g_quality_clean_windows = 0;
+    }
+
+    g_quality_frames = 0;
+    g_quality_misses = 0;
+}
+
+
+/* Times the work of the render slot that just ended. */
+static void frame_scheduler_check_deadline() {
+    uint32_t work = osKernelGetSysTimerCount() - g_render_start_sys;
+    bool missed = work > g_slot_period_sys;
+
+    if (missed) {
+        uint32_t overrun_us = (uint32_t) (((uint64_t) (work - g_slot_period_sys) * 1000000U) / osKernelGetSysTimerFreq());
+        g_stats.deadline_misses++;
+        if (overrun_us > g_stats.max_overrun_us) {
+            g_stats.max_overrun_us = overrun_us;
+        }
+    }
+    frame_scheduler_adapt_quality(missed);
+}
+
+
+/**
+ * @brief Blocks until the next slot starts.
+ *
+ * Every subframes-th slot is a render slot. When the loop falls a whole slot
+ * behind, the missed slots are dropped instead of being run back to back.
+ *
+ * @return What the slot is for.
+ */
+FrameSlot frame_scheduler_wait() {
+    if (g_render_pending) {
+        frame_scheduler_check_deadline();
+        g_render_pending = false;
+    }
+
+    g_next_slot_q16 += g_slot_period_q16;
+
+    /* The slot due is a render slot, the new slots apply from it on. */
+    if (g_slot == 0 && g_next_subframes != g_subframes) {
+        g_subframes = g_next_subframes;
+        frame_scheduler_set_rate(g_frames_per_second);
+    }
+
+    uint32_t deadline = (uint32_t) (g_next_slot_q16 >> 16);
+    uint32_t now = osKernelGetTickCount();
+
+    if ((int32_t) (deadline - now) > 0) {
+        osDelayUntil(deadline);
+    } else if (((uint64_t) (now - deadline) << 16) >= g_slot_period_q16) {
+        g_stats.late_slots++;
+        g_next_slot_q16 = (uint64_t) now << 16;
+    }
+
+    FrameSlot slot = g_slot == 0 ? FRAME_SLOT_RENDER : FRAME_SLOT_SUBFRAME;
+    g_slot = (g_slot + 1) % g_subframes;
+
+    if (slot == FRAME_SLOT_RENDER) {
+        g_render_start_sys = osKernelGetSysTimerCount();
+        g_render_pending = true;
+        g_stats.frames++;
+        g_window_frames++;
+
+        now = osKernelGetTickCount();
+        uint32_t window = now - g_window_start;
+        if (window >= osKernelGetTickFreq()) {
+            g_stats.fps_x100 = (uint32_t) (((uint64_t) g_window_frames * 100U * osKernelGetTickFreq()) / window);
+            g_window_start = now;
+            g_window_frames = 0;
+        }
+    }
+
+    return slot;
+}
+
+
+/**
+ * @brief Starts the pacing over after the loop stopped calling
+ * frame_scheduler_wait(), e.g. while the system was powered off.
+ *
+ * The next wait returns a render slot right away instead of counting the
+ * time in between as late slots, and the render that was running when the
+ * loop stopped is not timed.
+ */
+void frame_scheduler_restart() {
+    uint32_t now = osKernelGetTickCount();
+
+    g_next_slot_q16 = ((uint64_t) now << 16) - g_slot_period_q16;
+    g_slot = 0;
+    g_render_pending = false;
+    g_window_start = now;
+    g_window_frames = 0;
+}
+
+
+int frame_scheduler_get_quality() {
+    return g_stats.quality;
+}
+
+
+void frame_scheduler_get_stats(struct frame_scheduler_stats *stats) {
+    *stats = g_stats;
+}
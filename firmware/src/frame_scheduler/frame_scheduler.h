@@ -0,0 +1,32 @@
+/*
+ * File: frame_scheduler.h
+ * Description: Paces the main loop to the frame rate with the RTOS, instead of
+ * polling the tick count, so the time between frames goes to the idle sleep hook.
+ * It also watches whether frames finish in time and picks the quality level the
+ * LED filters render at.
+ */
+#pragma once
+#include <stdint.h>
+
+// Enum to define what a scheduler slot is for.
+typedef enum {
+    FRAME_SLOT_RENDER,      // render and send a new frame
+    FRAME_SLOT_SUBFRAME,    // only advance the output, e.g. the next dither step
+} FrameSlot;
+
+struct frame_scheduler_stats {
+    uint32_t frames;        // render slots since init
+    uint32_t late_slots;    // slots that started a whole slot late and were dropped
+    uint32_t fps_x100;      // render slots per second over the last second, times 100
+    uint32_t deadline_misses;   // frames whose render took longer than its slot
+    uint32_t max_overrun_us;    // longest a render ran past the end of its slot
+    int quality;            // current quality level, 0 is full quality
+};
+
+int frame_scheduler_init(uint32_t frames_per_second, int subframes);  // Starts pacing at frames_per_second with subframes slots per frame
+void frame_scheduler_set_rate(uint32_t frames_per_second);            // Changes the frame rate from the next slot on
+void frame_scheduler_set_subframes(int subframes);                    // Changes the slots per frame from the next render slot on
+FrameSlot frame_scheduler_wait();                                     // Blocks until the next slot starts
+void frame_scheduler_restart();                                       // Starts over with a render slot right away, e.g. after power off
+int frame_scheduler_get_quality();                                    // Quality level for the next frame, 0 to FRAME_QUALITY_LEVELS - 1
+void frame_scheduler_get_stats(struct frame_scheduler_stats *stats);
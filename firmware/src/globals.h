@@ -23,14 +23,10 @@
 #include <stdbool.h>
 
 
-extern volatile bool flag_toggle_system_power;  // Flag variable to signal events
-extern volatile bool is_system_on;
-
-
-
 #define NUM_PIXELS (50)
 #define MAX_REGISTER_READ_RETRIES (50)
 #define DEBUG_PRINT_ICM20649 // uncomment to enable debug statements
+//#define PROFILE_FRAME_STAGES // uncomment to log cycle counts of the frame stages in debug builds, see profiler/profiler.h
 
 #define GPIO_PUSH_BTN_1 (100) //PB00
 #define GPIO_PUSH_BTN_2 (101) //PB01
@@ -46,9 +42,36 @@ extern volatile bool is_system_on;
 #define SPI_MEMORY_MAPPED_ADDRESS (0x5005C000UL)
 #define SPI_GPIO_MOSI (102) //PB02
 #define SPI_GPIO_CLOCK (206) //PC06
-#define SPI_BAUDRATE (2500000) // 2.5 mHz
+#define SPI_BAUDRATE (2500000) // 2.5 mHz, use ~3.2 mHz with WS2812B_ENCODING_4BIT
 #define SPI_GPIO_CHIP_SELECT (204) //PC04
 
+/* WS2812B bit encoding, see ws2812b/ws2812b_encoding.h. Checked against SPI_BAUDRATE at compile time. */
+#define WS2812B_ENCODING (WS2812B_ENCODING_3BIT_WORD)
+
+/* Baudrates of the other chipsets in ws2812b/led_protocol.h */
+#define SK6812_SPI_BAUDRATE (3200000) // 3.2 mHz, 4 SPI bits per data bit
+#define APA102_SPI_BAUDRATE (8000000) // 8 mHz, clocked, no bit expansion
+
+/* WS2812B latch timer */
+#define LATCH_TIMER_MEMORY_MAPPED_ADDRESS (0x50048000UL) // TIMER0, EFR32xG24 Wireless SoC Reference Manual
+#define WS2812B_RESET_US (80) // low line that latches a frame, WS2812B needs >= 50 us and SK6812 >= 80 us
+
+/* Watchdog of the frame stages */
+#define WATCHDOG_MEMORY_MAPPED_ADDRESS (0x5B008000UL) // WDOG1, EFR32xG24 Wireless SoC Reference Manual
+#define EMU_MEMORY_MAPPED_ADDRESS (0x50004000UL) // EMU, holds the reset cause, EFR32xG24 Wireless SoC Reference Manual
+#define WATCHDOG_PERIOD_MS (256) // reset when no frame fed the watchdog for this long
+#define WATCHDOG_STAGE_DEADLINE_MS (100) // longest a frame stage may go without checking in
+
+
+/* Deferred logging of the hot path, see trace_log/trace_log.h */
+#ifdef DEBUG
+#define TRACE_LOG_LEVEL (CW_LOGLVL_DEBUG) // TRACE_* calls above this level compile to nothing
+#else
+#define TRACE_LOG_LEVEL (CW_LOGLVL_WARNING)
+#endif
+#define TRACE_LOG_RING_ENTRIES (128) // 32 bytes each, must be a power of two
+#define TRACE_LOG_FLUSH_MS (20) // the formatter thread drains the ring this often
+
 
 /* LEDFilter Defines */
 /* General Settings*/
@@ -76,6 +99,9 @@ extern volatile bool is_system_on;
 
 #define MAPPING_MODE (MAP_MODE_SYMMETRICAL)
 
+/* Frames over which a mode change crossfades, see filter_handler/filter_handler.cpp. 0 switches at once. */
+#define FILTER_TRANSITION_FRAMES (30)
+
 /* LEDFilter_Wave settings*/
 #define FILTER_WAVE_SMOOTHING (4.9)
 #define FILTER_WAVE_FREQUENCY (0.005)
@@ -84,8 +110,52 @@ extern volatile bool is_system_on;
 /* LEDFilter_Star settings*/
 #define FILTER_STAR_FREQUENCY_FACTOR (.001)
 #define FILTER_STAR_FADE_SPEED (4)
-
-#define FRAME_TIME_MS (17)
+#define FILTER_STAR_VELOCITY_FACTOR (0.01) // pixels per frame per unit of the smoothed z gyro
+#define FILTER_STAR_BURST_THRESHOLD (8) // rise of the accel magnitude within a frame that spawns a burst of stars
+
+/* LED geometry, see led_geometry/led_geometry.h */
+#define LED_WHEEL_RADIUS_MM (311) // axle to rim of a 622 mm (28 inch) rim, radius 1.0 in the geometry
+#define LED_GEOMETRY_RINGS (8) // radius groups the LEDs are sorted into, hub first
+
+/* Persistence of vision, see led_filters/LEDFilter_POV.h */
+#define POV_SUBFRAMES (8) // columns per frame, 480 per second at 60 fps. Sending a column to 50 LEDs takes ~1.6 ms, the kernel tick must be 1 kHz or faster
+#define POV_LATENCY_US (1700) // first guess of the time from rendering a column to its latch, measured from then on
+
+/* Wheel angle estimation, see wheel_phase/wheel_phase.h */
+#define WHEEL_GYRO_AXIS (2) // ICM axis along the axle
+#define WHEEL_GYRO_SIGN (1) // -1 if the rate of that axis is negative when riding forward
+#define WHEEL_ACCEL_AXIS_U (0) // ICM axes in the wheel plane, the gyro axis points along U x V
+#define WHEEL_ACCEL_AXIS_V (1)
+#define WHEEL_UP_OFFSET_DEG (0) // angle from the U axis to gravity when the valve hole is at the top
+#define WHEEL_GRAVITY_MIN_DPS (180) // gravity only corrects the angle above half a turn per second
+#define WHEEL_GRAVITY_GAIN (0.05f) // share of the angle error corrected per sample
+#define WHEEL_GYRO_BIAS_GAIN (0.03f) // gyro bias in degrees per second learned per degree of angle error and sample
+#define WHEEL_ACCEL_MEAN_GAIN (0.02f) // two running means that remove the centripetal acceleration, ~1.7 s at 60 fps
+
+/* Particle engine, see particles/particles.h */
+#define PARTICLE_POOL_CAPACITY (256)
+
+/* Power state settings, see power_state/power_state.cpp */
+#define POWER_BUTTON_DEBOUNCE_MS (50) // presses closer than this to the last one are contact bounce
+#define POWER_RESUME_BUDGET_US (50000) // longest allowed time from the power button to the first frame
+
+#define FRAME_RATE_FPS (60) // need not divide the kernel tick, see frame_scheduler/frame_scheduler.cpp
+
+/* Adaptive filter quality, see frame_scheduler/frame_scheduler.cpp */
+#define FRAME_QUALITY_LEVELS (4) // level 0 is full quality, each filter clamps to the levels it has
+#define FRAME_QUALITY_WINDOW_FRAMES (30) // frames over which deadline misses are counted, 0.5 s
+#define FRAME_QUALITY_DOWN_MISSES (3) // misses within a window that lower the quality
+#define FRAME_QUALITY_UP_WINDOWS (4) // windows without a miss before the quality goes up again
+
+/* LED strip settings */
+#define LED_STRIP_PIXEL_FORMAT (PIXEL_FORMAT_RGB888) // layout of the frame filters render into, see ws2812b/frame_buffer.h
+#define LED_STRIP_REFRESH_FRAMES (60) // resend an unchanged frame about once a second
+#define LED_STRIP_DITHER_SUBFRAMES (4) // output frames per render frame, the extra ones only advance the dithering
+#define LED_STRIP_STATS_REPORT_FRAMES (300) // debug builds log the encode/transfer savings every ~5 seconds
+#define LED_STRIP_CURRENT_BUDGET_MA (1500) // estimated strip current above which the brightness limiter dims the frame
+#define LED_STRIP_BRIGHTNESS_MIN (6554) // the limiter never dims below 10 % (Q16)
+#define LED_STRIP_BRIGHTNESS_RECOVERY (1024) // Q16 brightness regained per frame while there is headroom, ~1 s to full
+#define LED_STRIP_BRIGHTNESS_HYSTERESIS (1024) // Q16 margin the limiter dims below the budget, and smallest step it takes back up
 
 
 
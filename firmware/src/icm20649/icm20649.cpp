@@ -24,6 +24,7 @@
 #include "icm20649_defines.h"
 #include "globals.h"
 #include "logging.h"
+#include "trace_log/trace_log.h"
 #include "icm20649.h"
 #include <kernel.h>
 #include "utils/combine_bytes.h"
@@ -143,13 +144,13 @@ uint8_t icm_20649_return_register_val(uint8_t reg) {
 }
 
 /**
- * @brief Writes data to a register of the ICM20649 sensor.
+ * @brief Writes data to a register of the ICM20649 sensor without waiting afterwards.
  *
  * @param reg The register address to which the data will be written.
  * @param data The data to be written to the register.
  * @return 0 on success, -1 on failure.
  */
-int icm_20649_write_reg(uint8_t reg, uint8_t data) {
+static int icm_20649_send_reg(uint8_t reg, uint8_t data) {
     memset(p_write_buffer, data, WRITE_BUFFER_SIZE_BYTES);
 
     int result = i2c_write_reg(i2c_device, ICM_20649_DEVICE_ADDRESS, reg, p_write_buffer, WRITE_BUFFER_SIZE_BYTES);
@@ -158,12 +159,53 @@ int icm_20649_write_reg(uint8_t reg, uint8_t data) {
         return -1;
     }
 
+    TRACE_DEBUG("icm_20649_write_reg(): Successfully wrote 0x%02X to register 0x%02X.", data, reg);
+    return 0;
+}
+
+/**
+ * @brief Writes data to a register of the ICM20649 sensor.
+ *
+ * @param reg The register address to which the data will be written.
+ * @param data The data to be written to the register.
+ * @return 0 on success, -1 on failure.
+ */
+int icm_20649_write_reg(uint8_t reg, uint8_t data) {
+    if (icm_20649_send_reg(reg, data) == -1) {
+        return -1;
+    }
+
     // Delay to prevent outdated register reads
     osDelayUntil(ts + 15);
-    LOG_DEBUG("icm_20649_write_reg(): Successfully wrote 0x%02X to register 0x%02X.", data, reg);
     return 0;
 }
 
+/**
+ * @brief Puts the ICM20649 sensor into sleep mode.
+ *
+ * Register bank 0 is selected after initialization, so PWR_MGMT_1 can be
+ * written directly. Nothing is read before the wake, so the write does not wait.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int icm_20649_sleep() {
+    return icm_20649_send_reg(ICM_20649_B0_PWR_MGMT_1, ICM_20649_B0_PWR_MGMT_1_SLEEP);
+}
+
+/**
+ * @brief Wakes the ICM20649 sensor from sleep mode.
+ *
+ * The accelerometer needs about 20 ms and the gyroscope about 35 ms to
+ * start up, reads in that time return stale data. The write does not wait
+ * for that, or for the delay of icm_20649_write_reg(): it is on the resume
+ * path, and the frames until the data is fresh render from the last values.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int icm_20649_wake() {
+    return icm_20649_send_reg(ICM_20649_B0_PWR_MGMT_1, ICM_20649_B0_PWR_MGMT_1_SETTINGS);
+}
+
 /**
  * @brief Reads accelerometer data from the ICM20649 sensor.
  *
@@ -191,19 +233,19 @@ int icm_20649_read_accel_data(float accel_data[]) {
             raw_accel_vals[i] = icm_20649_return_register_val(reg_addrs[i]);
             if (raw_accel_vals[i] != (uint8_t)-1) {
 #ifdef DEBUG_PRINT_ICM20649
-                LOG_DEBUG("icm_20649_read_accel_data: Success reading register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
+                TRACE_DEBUG("icm_20649_read_accel_data: Success reading register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
 #endif
                 last_valid_accel_vals[i] = raw_accel_vals[i]; // Update last valid value
                 break; // Successful read
             }
             retries++;
 #ifdef DEBUG_PRINT_ICM20649
-            LOG_DEBUG("icm_20649_read_accel_data: Failed to read register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
+            TRACE_DEBUG("icm_20649_read_accel_data: Failed to read register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
 #endif
         }
         if (retries == MAX_REGISTER_READ_RETRIES) {
 #ifdef DEBUG_PRINT_ICM20649
-            LOG_DEBUG("icm_20649_read_accel_data: Failed to read register 0x%02X (index %d) after %d attempts.", reg_addrs[i], i, MAX_REGISTER_READ_RETRIES);
+            TRACE_DEBUG("icm_20649_read_accel_data: Failed to read register 0x%02X (index %d) after %d attempts.", reg_addrs[i], i, MAX_REGISTER_READ_RETRIES);
 #endif
             raw_accel_vals[i] = last_valid_accel_vals[i]; // Use last valid value
         }
@@ -219,7 +261,7 @@ int icm_20649_read_accel_data(float accel_data[]) {
         } else {
             accel_data[i] = 0; // Default value in case of failure
 #ifdef DEBUG_PRINT_ICM20649
-            LOG_DEBUG("icm_20649_read_accel_data: Using default value for axis %d due to read failure.", i);
+            TRACE_DEBUG("icm_20649_read_accel_data: Using default value for axis %d due to read failure.", i);
 #endif
         }
     }
@@ -254,19 +296,19 @@ int icm_20649_read_gyro_data(float gyro_data[]) {
             raw_gyro_vals[i] = icm_20649_return_register_val(reg_addrs[i]);
             if (raw_gyro_vals[i] != (uint8_t)-1) {
 #ifdef DEBUG_PRINT_ICM20649
-                LOG_DEBUG("icm_20649_read_gyro_data: Success reading register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
+                TRACE_DEBUG("icm_20649_read_gyro_data: Success reading register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
 #endif
                 last_valid_gyro_vals[i] = raw_gyro_vals[i]; // Update last valid value
                 break; // Successful read
             }
             retries++;
 #ifdef DEBUG_PRINT_ICM20649
-            LOG_DEBUG("icm_20649_read_gyro_data: Failed to read register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
+            TRACE_DEBUG("icm_20649_read_gyro_data: Failed to read register 0x%02X (index %d), attempt %d.", reg_addrs[i], i, retries);
 #endif
         }
         if (retries == MAX_REGISTER_READ_RETRIES) {
 #ifdef DEBUG_PRINT_ICM20649
-            LOG_DEBUG("icm_20649_read_gyro_data: Failed to read register 0x%02X (index %d) after %d attempts.", reg_addrs[i], i, MAX_REGISTER_READ_RETRIES);
+            TRACE_DEBUG("icm_20649_read_gyro_data: Failed to read register 0x%02X (index %d) after %d attempts.", reg_addrs[i], i, MAX_REGISTER_READ_RETRIES);
 #endif
             raw_gyro_vals[i] = last_valid_gyro_vals[i]; // Use last valid value
         }
@@ -282,7 +324,7 @@ int icm_20649_read_gyro_data(float gyro_data[]) {
         } else {
             gyro_data[i] = 0; // Default value in case of failure
 #ifdef DEBUG_PRINT_ICM20649
-            LOG_DEBUG("icm_20649_read_gyro_data: Using default value for axis %d due to read failure.", i);
+            TRACE_DEBUG("icm_20649_read_gyro_data: Using default value for axis %d due to read failure.", i);
 #endif
         }
     }
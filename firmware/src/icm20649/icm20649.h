@@ -29,6 +29,18 @@ uint8_t icm_20649_return_register_val(uint8_t reg);
  */
 int icm_20649_write_reg(uint8_t reg, uint8_t data);
 
+/**
+ * @brief Puts the sensor into sleep mode.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int icm_20649_sleep();
+
+/**
+ * @brief Wakes the sensor from sleep mode.
+ * @return 0 on success, or a negative error code on failure.
+ */
+int icm_20649_wake();
+
 /**
  * @brief Reads acceleration data.
  * @param accel_data Array to store the data.
@@ -102,4 +102,9 @@
  * - keeps temperature sensor on
  * - uses 'best clock source' according to docs,
  *   for internal clock */
-#define ICM_20649_B0_PWR_MGMT_1_SETTINGS (0x01)
\ No newline at end of file
+#define ICM_20649_B0_PWR_MGMT_1_SETTINGS (0x01)
+
+/* The same with the SLEEP bit (bit 6) set: all sensors and the
+ * digital logic are powered down, only the serial interface
+ * stays up so the wake write can reach the chip. */
+#define ICM_20649_B0_PWR_MGMT_1_SLEEP (0x41)
\ No newline at end of file
@@ -3,13 +3,30 @@
 #include "icm20649/icm20649.h"
 #include "ws2812b/ws2812b.h"
 #include "globals.h"
+#include <algorithm>
+
+/* Sensor data of the current frame, defined and updated in main.cpp. */
+extern float accel_data[3];
+extern float gyro_data[3];
+extern float smooth_accel_data[3];
+extern float smooth_gyro_data[3];
+extern uint8_t mapped_accel_data[3];
+extern uint8_t mapped_gyro_data[3];
+extern uint8_t magnitude_mapped_accel_data;
+extern uint8_t magnitude_mapped_gyro_data;
 
 /**
- * @brief Abstract base class for LED filters.
+ * @brief Base class for LED filters.
+ *
+ * The `LEDFilter` class is the common base of the LED filters. A filter derives
+ * from it and implements
+ *
+ *     void apply_filter(FrameBuffer *frame);
  *
- * The `LEDFilter` class serves as an abstract base class for implementing various
- * filters that can be applied to LED data. It provides a common interface for
- * applying filters, which derived classes must implement.
+ * and, if it offers cheaper ways to render, `int quality_levels() const`. The
+ * functions are not virtual: the filter registry (filter_handler/filter_registry.h)
+ * knows the type of every filter and calls them directly, so they inline into the
+ * frame loop.
  *
  * This file shows the values that are available to each filter, supporting easy and
  * consistent Filter development experience, and controlling memory usage by constriciting
@@ -21,49 +38,73 @@ public:
     /**
      * @brief Default constructor.
      *
-     * Initializes the `LEDFilter` object. The default constructor does not perform
-     * any special initialization.
+     * Initializes the `LEDFilter` object. A filter is constructed when it becomes
+     * the current one, so it starts with fresh state every time.
      */
     LEDFilter() = default;
 
     /**
-     * @brief Pure virtual function to apply the filter.
+     * @brief Number of quality levels the filter offers.
      *
-     * Derived classes must implement this method to apply a specific filter to
-     * the LED data. The method does not return any value and modifies the LED data
-     * according to the filter's algorithm.
+     * Level 0 is full quality, every higher level renders cheaper. Filters that
+     * cost little keep the single default level.
      */
-    virtual void apply_filter() = 0;
-
-protected:
+    int quality_levels() const { return 1; }
 
     /**
-     * @brief Pointer to the array of acceleration data.
+     * @brief Slots per frame the filter renders in.
      *
-     * This static member points to an array containing acceleration data. Derived
-     * classes can use this pointer to access or modify the acceleration data.
+     * 0 renders once per frame and the slots in between advance the dithering.
+     * Filters that render faster than the frame rate, like LEDFilter_POV, set it
+     * to the slots per frame they need and are called in every slot.
      */
-    static float* p_accel_data;
-    static float* p_gyro_data;
+    static constexpr int SUBFRAMES = 0;
 
-    static float* p_smooth_accel_data;
-    static float* p_smooth_gyro_data;
+    /**
+     * @brief Sets the quality level of the next frames.
+     *
+     * Use led_filter_set_quality(), which clamps the level to the levels the
+     * filter offers.
+     */
+    void set_quality(int level) {
+        quality = level;
+    }
 
-    static uint8_t* p_mapped_accel_data;
-    static uint8_t* p_mapped_gyro_data;
+    int get_quality() const {
+        return quality;
+    }
 
-    static uint8_t* p_magnitude_mapped_accel_data;
-    static uint8_t* p_magnitude_mapped_gyro_data;
+protected:
 
+    int quality = 0;        ///< current quality level, 0 is full quality
 
     /**
-     * @brief Pointer to the array of virtual LED data.
+     * @brief Pointer to the array of acceleration data.
      *
-     * This static member points to a 2D array where each row contains the RGB values
-     * of a virtual LED. Derived classes can use this pointer to access or modify
-     * the virtual LED data.
+     * These static members point to the sensor data in main.cpp. They are
+     * constants, so a filter reads the data at its fixed address.
      */
-    static uint8_t (*p_virtual_leds)[3];
-    static uint8_t (*p_hsv_virtual_leds)[3];
+    static constexpr float* p_accel_data = accel_data;
+    static constexpr float* p_gyro_data = gyro_data;
+
+    static constexpr float* p_smooth_accel_data = smooth_accel_data;
+    static constexpr float* p_smooth_gyro_data = smooth_gyro_data;
+
+    static constexpr uint8_t* p_mapped_accel_data = mapped_accel_data;
+    static constexpr uint8_t* p_mapped_gyro_data = mapped_gyro_data;
+
+    static constexpr uint8_t* p_magnitude_mapped_accel_data = &magnitude_mapped_accel_data;
+    static constexpr uint8_t* p_magnitude_mapped_gyro_data = &magnitude_mapped_gyro_data;
 
 };
+
+/**
+ * @brief Sets the quality level of a filter, clamped to the levels it offers.
+ *
+ * Called by the filter handler with the level the frame scheduler picked when
+ * frames miss their deadline.
+ */
+template <typename Filter>
+inline void led_filter_set_quality(Filter &filter, int level) {
+    filter.set_quality(std::clamp(level, 0, filter.quality_levels() - 1));
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "LEDFilter.h"
+
+class LEDFilter_Basic : public LEDFilter {
+public:
+    LEDFilter_Basic() = default;
+
+    void apply_filter(FrameBuffer *frame) {
+        // Set LED colors based on smoothed values, combining both accelerometer and gyroscope influences
+        frame_buffer_fill(frame,
+                          (p_mapped_accel_data[0] + p_mapped_gyro_data[0]) / 2,
+                          (p_mapped_accel_data[1] + p_mapped_gyro_data[1]) / 2,
+                          (p_mapped_accel_data[2] + p_mapped_gyro_data[2]) / 2);
+    }
+
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include "LEDFilter.h"
+#include <cmath> // For sin, floor, and M_PI
+
+class LEDFilter_BicycleWheel : public LEDFilter {
+public:
+    LEDFilter_BicycleWheel() = default;
+
+
+    void apply_filter(FrameBuffer *frame) {
+
+        for (int i = 0; i < frame->num_pixels; i = i + 2) {
+            frame_buffer_set_rgb(frame, i, p_mapped_accel_data[0], p_mapped_accel_data[1], p_mapped_accel_data[2]);
+        }
+        for (int i = 1; i < frame->num_pixels; i = i + 2) {
+            frame_buffer_set_rgb(frame, i, p_mapped_gyro_data[0], p_mapped_gyro_data[1], p_mapped_gyro_data[2]);
+        }
+
+    }
+
+private:
+
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include "LEDFilter.h"
+#include "utils/blend_simd.h"
+#include <stddef.h>
+#include <tuple>
+#include <utility>
+
+// Enum to define which sensor feature sets the opacity of a layer.
+typedef enum {
+    LAYER_OPACITY_FIXED,    // always opacity_max
+    LAYER_OPACITY_ACCEL,    // magnitude of the mapped accelerometer data
+    LAYER_OPACITY_GYRO,     // magnitude of the mapped gyroscope data
+} LayerOpacitySource;
+
+/**
+ * @brief How one layer of a composite is blended.
+ *
+ * The opacity follows the sensor feature from opacity_min at 0 to opacity_max at 255.
+ */
+struct CompositeLayer {
+    BlendMode mode;
+    LayerOpacitySource source;
+    uint8_t opacity_min;
+    uint8_t opacity_max;
+};
+
+/**
+ * @brief Renders a stack of filters and blends them into one frame.
+ *
+ * Layers lists the filter types bottom first, and Config holds one CompositeLayer
+ * per filter, the one of the bottom layer is not used. The bottom layer renders
+ * straight into the frame. Every layer above renders into a layer frame and is
+ * blended onto the frame with its blend mode and opacity, so the layers are
+ * composed bottom-up one at a time and share a single layer frame.
+ */
+template <const CompositeLayer *Config, typename... Layers>
+class LEDFilter_Composite : public LEDFilter {
+public:
+    LEDFilter_Composite() = default;
+
+    void apply_filter(FrameBuffer *frame) {
+        apply_layers(frame, std::index_sequence_for<Layers...>());
+    }
+
+    int quality_levels() const {
+        return quality_levels(std::index_sequence_for<Layers...>());
+    }
+
+private:
+    std::tuple<Layers...> layers;
+
+    // Shared by all composites, a composite only uses it within apply_filter()
+    static inline uint8_t layer_pixels[NUM_PIXELS * PIXEL_FORMAT_BYTES(LED_STRIP_PIXEL_FORMAT)];
+
+    template <size_t... I>
+    void apply_layers(FrameBuffer *frame, std::index_sequence<I...>) {
+        (apply_layer<I>(frame), ...);
+    }
+
+    template <size_t I>
+    void apply_layer(FrameBuffer *frame) {
+        auto &filter = std::get<I>(layers);
+        led_filter_set_quality(filter, quality);
+
+        if constexpr (I == 0) {
+            filter.apply_filter(frame);
+        } else {
+            uint32_t weight = opacity(Config[I]);
+            if (weight == 0) {
+                return;
+            }
+            FrameBuffer layer_frame = *frame;
+            layer_frame.pixels = layer_pixels;
+            filter.apply_filter(&layer_frame);
+            blend_bytes(frame->pixels, layer_frame.pixels, frame->num_pixels * frame->bytes_per_pixel, Config[I].mode, weight);
+        }
+    }
+
+    template <size_t... I>
+    int quality_levels(std::index_sequence<I...>) const {
+        return std::max({1, std::get<I>(layers).quality_levels()...});
+    }
+
+    // Opacity of a layer as a blend weight from 0 to 256
+    static uint32_t opacity(const CompositeLayer &layer) {
+        uint32_t feature;
+        switch (layer.source) {
+            case LAYER_OPACITY_ACCEL:
+                feature = *p_magnitude_mapped_accel_data;
+                break;
+            case LAYER_OPACITY_GYRO:
+                feature = *p_magnitude_mapped_gyro_data;
+                break;
+            default:
+                feature = 255;
+                break;
+        }
+        int value = layer.opacity_min + ((layer.opacity_max - layer.opacity_min) * static_cast<int>(feature)) / 255;
+        return static_cast<uint32_t>(value + (value >> 7));
+    }
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include "LEDFilter.h"
+#include "kernel.h"
+#include "led_geometry/led_geometry.h"
+#include "wheel_phase/wheel_phase.h"
+#include "utils/pov_image_table.c"
+
+/**
+ * @brief Persistence of vision: paints the polar image of pov_image_table.c onto the
+ * spinning wheel.
+ *
+ * Every pixel shows the image at the angle and radius it is at on the road, which is
+ * the wheel angle plus its angle on the wheel from led_geometry. The filter renders
+ * in every scheduler slot, SUBFRAMES per frame, and each column is rendered for the
+ * wheel angle at the moment it latches, not the moment it is rendered: the time from
+ * rendering to the latch is measured with led_strip_latch_time() and the wheel angle
+ * is extrapolated over it.
+ */
+class LEDFilter_POV : public LEDFilter {
+public:
+    static constexpr int SUBFRAMES = POV_SUBFRAMES;
+
+    LEDFilter_POV() {
+        latency_sys = (uint32_t) (((uint64_t) POV_LATENCY_US * osKernelGetSysTimerFreq()) / 1000000U);
+        max_latency_sys = osKernelGetSysTimerFreq() / FRAME_RATE_FPS;
+        last_latch_sys = led_strip_latch_time();
+    }
+
+    void apply_filter(FrameBuffer *frame) {
+        uint32_t now = osKernelGetSysTimerCount();
+        measure_latency(now);
+
+        uint32_t phase = wheel_phase_at(now + latency_sys);
+
+        for (int i = 0; i < frame->num_pixels; i++) {
+            const led_position &position = led_geometry.pixels[i];
+            uint32_t angle = phase + ((uint32_t) position.angle << 16);
+            const uint8_t *color = pov_image[angle >> (32 - POV_IMAGE_COLUMN_BITS)][(position.radius * POV_IMAGE_ROWS) >> 16];
+
+            frame_buffer_set_rgb(frame, i, color[0], color[1], color[2]);
+        }
+    }
+
+private:
+    uint32_t latency_sys;       // time from rendering a column to its latch, in system timer counts
+    uint32_t max_latency_sys;   // longer measurements did not come from the last column
+    uint32_t last_render_sys = 0;
+    uint32_t last_latch_sys;
+
+    /* A new latch time belongs to the column rendered last. Averaged over 8 columns. */
+    void measure_latency(uint32_t now) {
+        uint32_t latch = led_strip_latch_time();
+        if (latch != last_latch_sys && last_render_sys != 0) {
+            uint32_t measured = latch - last_render_sys;
+            if (measured <= max_latency_sys) {
+                latency_sys = latency_sys - (latency_sys >> 3) + (measured >> 3);
+            }
+        }
+        last_latch_sys = latch;
+        last_render_sys = now;
+    }
+};
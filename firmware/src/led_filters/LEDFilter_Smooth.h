@@ -0,0 +1,70 @@
+#pragma once
+#include "LEDFilter.h"
+#include "kernel.h"
+#include "particles/particles.h"
+#include "utils/xorshift.h"
+
+class LEDFilter_Smooth : public LEDFilter {
+public:
+    LEDFilter_Smooth(float star_frequency_factor = FILTER_STAR_FREQUENCY_FACTOR, float fade_speed = FILTER_STAR_FADE_SPEED)
+            : star_frequency_factor(star_frequency_factor), fade_speed(fade_speed) {
+        particle_pool_init(&stars);
+        // Seed random number generator, the filter is constructed at every mode change
+        random_state = xorshift32_seed(osKernelGetSysTimerCount());
+    }
+
+    void apply_filter(FrameBuffer *frame) {
+        // Update star frequency based on gyroscope data and factor
+        // Lower quality levels create half, a quarter, ... of the stars, fewer stars are lit to convert
+        star_frequency = static_cast<float>(*p_magnitude_mapped_gyro_data) * star_frequency_factor / static_cast<float>(1 << quality);
+        star_timer += star_frequency;
+
+        // Check if it's time to create a new star
+        while (star_timer >= 1.0f) {
+            create_star(frame->num_pixels);
+            star_timer -= 1.0f; // Reset timer, but keep the fraction for smooth timing
+        }
+
+        // A jolt, the accel magnitude rising quickly, sets off a burst of stars
+        int jolt = *p_magnitude_mapped_accel_data - last_accel_magnitude;
+        last_accel_magnitude = *p_magnitude_mapped_accel_data;
+        if (jolt > FILTER_STAR_BURST_THRESHOLD) {
+            for (int i = 0; i < (jolt >> quality); i++) {
+                create_star(frame->num_pixels);
+            }
+        }
+
+        // Render the stars, anti-aliased unless the quality is at its lowest, then move and fade them
+        particle_pool_render(&stars, frame, quality < quality_levels() - 1);
+        particle_pool_update(&stars, frame->num_pixels);
+    }
+
+    int quality_levels() const {
+        return 3;
+    }
+
+private:
+    float star_timer = 0.0f; // Timer for creating new stars
+    float star_frequency; // Frequency of new stars
+    float star_frequency_factor;
+    float fade_speed; // Speed of fading effect
+    uint8_t last_accel_magnitude = 0;
+    uint32_t random_state;
+    struct particle_pool stars;
+
+    void create_star(int num_pixels) {
+        struct particle *star = particle_spawn(&stars);
+        if (star == NULL) {
+            return; // Pool is full, the star is skipped
+        }
+
+        // Random position, drifting with the rotation around z and a little random spread
+        star->position = static_cast<int32_t>(xorshift32_below(&random_state, static_cast<uint32_t>(num_pixels)) << PARTICLE_POSITION_BITS)
+                         + static_cast<int32_t>(xorshift32_below(&random_state, PARTICLE_PIXELS(1)));
+        star->velocity = PARTICLE_PIXELS(p_smooth_gyro_data[2] * FILTER_STAR_VELOCITY_FACTOR)
+                         + static_cast<int32_t>(xorshift32_below(&random_state, PARTICLE_PIXELS(0.25))) - PARTICLE_PIXELS(0.125);
+        star->hue = *p_magnitude_mapped_accel_data; // Hue based on accel data
+        star->life = PARTICLE_LIFE_FULL; // Bright LED
+        star->decay = static_cast<uint16_t>(fade_speed * (1 << PARTICLE_LIFE_BITS));
+    }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include "LEDFilter.h"
+#include "utils/sine_q15.h"
+
+class LEDFilter_Wave : public LEDFilter {
+public:
+    LEDFilter_Wave(float smoothing_factor = FILTER_WAVE_SMOOTHING,
+                   float wave_frequency_factor = FILTER_WAVE_FREQUENCY,
+                   float wave_amplitude_factor = FILTER_WAVE_AMPLITUDE)
+            : smoothing_factor(smoothing_factor),
+            wave_frequency_factor(wave_frequency_factor),
+            wave_amplitude_factor(wave_amplitude_factor) {
+
+        // Initialize smooth values and wave position
+        for (int i = 0; i < 3; i++) {
+            smooth_values_accel[i] = 0;
+            smooth_values_gyro[i] = 0;
+        }
+        wave_phase = 0;
+    }
+
+    void apply_filter(FrameBuffer *frame) {
+        // Smoothly update smooth_values based on accelerometer and gyroscope data
+        for (int i = 0; i < 3; i++) {
+            smooth_values_accel[i] = (smooth_values_accel[i] * smoothing_factor + p_mapped_accel_data[i]) / (smoothing_factor + 1);
+            smooth_values_gyro[i] = (smooth_values_gyro[i] * smoothing_factor + p_mapped_gyro_data[i]) / (smoothing_factor + 1);
+        }
+
+        // Calculate wave frequency and amplitude based on smoothed sensor data
+        float wave_frequency = (smooth_values_gyro[0] + smooth_values_gyro[1] + smooth_values_gyro[2]) / 3.0f * wave_frequency_factor;
+        float wave_amplitude = (smooth_values_accel[0] + smooth_values_accel[1] + smooth_values_accel[2]) / 3.0f * wave_amplitude_factor;
+
+        // Advance the wave, the phase wraps at 2pi by overflowing
+        wave_phase += sine_phase_from_radians(wave_frequency);
+
+        // Gain 1 + amplitude * sin(phase) in Q12, the amplitude fits since the mapped data is at most 255
+        int32_t amplitude_q12 = static_cast<int32_t>(wave_amplitude * 4096.0f);
+        const uint8_t base_color[3] = {smooth_values_accel[0], smooth_values_accel[1], smooth_values_accel[2]};
+
+        // Set LED colors with a wave effect, one period over the strip. Lower quality levels
+        // evaluate the wave on every 2nd, 4th, ... pixel and repeat the colour in between.
+        int step = 1 << quality;
+        uint32_t phase_step = static_cast<uint32_t>((1ULL << 32) / frame->num_pixels) * step;
+        uint32_t phase = wave_phase;
+        for (int i = 0; i < frame->num_pixels; i += step, phase += phase_step) {
+            int32_t gain_q12 = 4096 + ((amplitude_q12 * sine_q15(phase)) >> 15);
+
+            // Calculate a color shift for variety
+            uint8_t color_shift[3] = {
+                    scale_channel(base_color[0], gain_q12),
+                    scale_channel(base_color[1], gain_q12),
+                    scale_channel(base_color[2], gain_q12)
+            };
+
+            for (int j = i; j < std::min(i + step, frame->num_pixels); j++) {
+                frame_buffer_set_rgb(frame, j, color_shift[0], color_shift[1], color_shift[2]);
+            }
+        }
+    }
+
+    int quality_levels() const {
+        return 3;
+    }
+
+private:
+    static inline uint8_t scale_channel(uint8_t value, int32_t gain_q12) {
+        int32_t scaled = (value * gain_q12) >> 12;
+        return static_cast<uint8_t>(scaled < 0 ? 0 : (scaled > 255 ? 255 : scaled));
+    }
+
+    float smoothing_factor;      // Smoothing factor for sensor data
+    float wave_frequency_factor; // Frequency factor for wave movement
+    float wave_amplitude_factor; // Amplitude factor for wave intensity
+
+    uint8_t smooth_values_accel[3]; // Smoothed acceleration data
+    uint8_t smooth_values_gyro[3];  // Smoothed gyroscope data
+    uint32_t wave_phase;            // Current position in the wave cycle, 2^32 is one period
+};
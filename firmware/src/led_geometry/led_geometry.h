@@ -0,0 +1,121 @@
+/*
+ * File: led_geometry.h
+ * Description: Physical position of every pixel, for filters that render in polar space.
+ *
+ * Pixel indices follow the strip, which is wound through the spokes, so neighbouring
+ * indices can be far apart on the wheel. led_geometry is built at compile time from
+ * the layout description in led_layout.h and lives in flash. It gives each pixel its
+ * angle, radius and spoke in fixed point, and two orders of the pixels that filters
+ * need often: sorted by angle, and grouped into LED_GEOMETRY_RINGS rings by radius.
+ * A filter looks these up instead of doing trigonometry per frame.
+ *
+ * Angles are binary angles, 65536 is a full turn, so an angle shifted left by 16 is
+ * a phase of utils/sine_q15.h and angle differences wrap on their own. Radii are a
+ * fraction of LED_WHEEL_RADIUS_MM, 65535 is the rim.
+ */
+#pragma once
+#include <stdint.h>
+#include "globals.h"
+#include "led_layout.h"
+
+#define LED_ANGLE_TURN (65536)          // binary angle of a full turn
+#define LED_RADIUS_RIM (65535)          // radius of the rim
+
+struct led_position {
+    uint16_t angle;     // binary angle, 0 at the valve hole
+    uint16_t radius;    // 0 at the axle, LED_RADIUS_RIM at the rim
+    uint8_t spoke;
+    uint8_t ring;       // radius group, 0 is nearest the hub
+};
+
+struct led_geometry_table {
+    led_position pixels[NUM_PIXELS];            // by pixel index
+    uint16_t by_angle[NUM_PIXELS];              // pixel indices sorted by angle
+    uint16_t by_ring[NUM_PIXELS];               // pixel indices grouped by ring, sorted by radius within a ring
+    uint16_t ring_start[LED_GEOMETRY_RINGS + 1]; // ring r is by_ring[ring_start[r] .. ring_start[r + 1] - 1]
+};
+
+
+constexpr int led_layout_pixels() {
+    int count = 0;
+    for (const led_run &run : led_layout) {
+        count += run.count;
+    }
+    return count;
+}
+
+static_assert(led_layout_pixels() == NUM_PIXELS, "led_layout.h must describe exactly NUM_PIXELS LEDs");
+
+
+/********************************************//**
+ *  Builds the geometry from the layout. Runs
+ *  in the compiler only, see led_geometry below.
+ ***********************************************/
+constexpr led_geometry_table led_geometry_build() {
+    led_geometry_table table{};
+    int pixel = 0;
+
+    for (const led_run &run : led_layout) {
+        for (int i = 0; i < run.count; i++) {
+            // Evenly spaced from the first to the last LED, in degrees * 65536 and um
+            int64_t span = run.count > 1 ? run.count - 1 : 1;
+            int64_t angle = (int64_t) run.angle_first * 65536 + (int64_t) (run.angle_last - run.angle_first) * 65536 * i / span;
+            int64_t radius_um = run.radius_first * 1000 + (run.radius_last - run.radius_first) * 1000 * i / span;
+
+            int64_t radius = radius_um * LED_RADIUS_RIM / (LED_WHEEL_RADIUS_MM * 1000);
+            radius = radius < 0 ? 0 : (radius > LED_RADIUS_RIM ? LED_RADIUS_RIM : radius);
+
+            led_position &position = table.pixels[pixel++];
+            position.angle = (uint16_t) (angle * LED_ANGLE_TURN / (360 * 65536));
+            position.radius = (uint16_t) radius;
+            position.spoke = run.spoke;
+            position.ring = (uint8_t) (radius * LED_GEOMETRY_RINGS / (LED_RADIUS_RIM + 1));
+        }
+    }
+
+    // Insertion sorts, the tables are small and this is not run on the target
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        int j = i;
+        for (; j > 0 && table.pixels[table.by_angle[j - 1]].angle > table.pixels[i].angle; j--) {
+            table.by_angle[j] = table.by_angle[j - 1];
+        }
+        table.by_angle[j] = (uint16_t) i;
+    }
+
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        int j = i;
+        for (; j > 0 && table.pixels[table.by_ring[j - 1]].radius > table.pixels[i].radius; j--) {
+            table.by_ring[j] = table.by_ring[j - 1];
+        }
+        table.by_ring[j] = (uint16_t) i;
+    }
+
+    int ring = 0;
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        while (ring <= table.pixels[table.by_ring[i]].ring) {
+            table.ring_start[ring++] = (uint16_t) i;
+        }
+    }
+    while (ring <= LED_GEOMETRY_RINGS) {
+        table.ring_start[ring++] = NUM_PIXELS;
+    }
+
+    return table;
+}
+
+inline constexpr led_geometry_table led_geometry = led_geometry_build();
+
+
+/**
+ * @brief Shortest angle from a to b, positive in the direction the wheel turns.
+ */
+static inline int16_t led_angle_diff(uint16_t a, uint16_t b) {
+    return (int16_t) (uint16_t) (b - a);
+}
+
+/**
+ * @brief Number of pixels in a ring, the pixels are led_geometry.by_ring[led_geometry.ring_start[ring] ...].
+ */
+static inline int led_geometry_ring_size(int ring) {
+    return led_geometry.ring_start[ring + 1] - led_geometry.ring_start[ring];
+}
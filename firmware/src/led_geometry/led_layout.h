@@ -0,0 +1,36 @@
+/*
+ * File: led_layout.h
+ * Description: Where the LEDs sit on the wheel, the input of led_geometry.h.
+ *
+ * The strip is wound through the spokes, so it is described as straight runs of
+ * LEDs, one per spoke or rim section, in the order of the frame (the order of
+ * led_strip_layout in sysconfig.c). A run gives the position of its first and last
+ * LED in polar coordinates, the LEDs in between are spaced evenly. Angles are in
+ * degrees, counted in the direction the wheel turns from the valve hole, radii in
+ * mm from the axle. Laced spokes leave the hub at a tangent, so a run that goes out
+ * along a spoke ends at a different angle than it starts.
+ *
+ * Change this table when the strip is wound differently, the geometry is rebuilt
+ * from it at compile time.
+ */
+#pragma once
+#include <stdint.h>
+
+struct led_run {
+    uint8_t spoke;          // spoke (or rim section) the LEDs are fixed to
+    uint16_t count;         // LEDs in the run
+    int16_t angle_first;    // degrees
+    int16_t angle_last;
+    uint16_t radius_first;  // mm
+    uint16_t radius_last;
+};
+
+/* 50 LEDs, out along spoke 0, back in along spoke 7, out along 14, ... of a 36 spoke wheel. */
+static constexpr led_run led_layout[] = {
+    // spoke, count, angle first, angle last, radius first, radius last
+    {0,  10, 0,   8,   50,  290},
+    {7,  10, 78,  70,  290, 50},
+    {14, 10, 140, 148, 50,  290},
+    {22, 10, 228, 220, 290, 50},
+    {29, 10, 290, 298, 50,  290},
+};
@@ -6,7 +6,12 @@
 #include "icm20649/icm20649.h"
 #include "buttons/buttons.h"
 #include "filter_handler/filter_handler.h"
-#include "utils/power_toggle.c"
+#include "frame_scheduler/frame_scheduler.h"
+#include "profiler/profiler.h"
+#include "power_state/power_state.h"
+#include "watchdog/watchdog.h"
+#include "trace_log/trace_log.h"
+#include "wheel_phase/wheel_phase.h"
 #include "utils/map_value.h"
 #include "led_filters/LEDFilter.h"
 
@@ -21,37 +26,18 @@ uint8_t mapped_accel_data[3];
 uint8_t mapped_gyro_data[3];
 uint8_t magnitude_mapped_accel_data;
 uint8_t magnitude_mapped_gyro_data;
-uint8_t virtual_leds[NUM_PIXELS][3];
-uint8_t hsv_virtual_leds[NUM_PIXELS][3];
 
-
-/* Pointers for LEDFilter access */
-float *LEDFilter::p_accel_data = accel_data;
-float *LEDFilter::p_gyro_data = gyro_data;
-
-float *LEDFilter::p_smooth_accel_data = smooth_accel_data;
-float *LEDFilter::p_smooth_gyro_data = smooth_gyro_data;
-
-uint8_t *LEDFilter::p_mapped_accel_data = mapped_accel_data;
-uint8_t *LEDFilter::p_mapped_gyro_data = mapped_gyro_data;
-
-uint8_t *LEDFilter::p_magnitude_mapped_accel_data = &magnitude_mapped_accel_data;
-uint8_t *LEDFilter::p_magnitude_mapped_gyro_data = &magnitude_mapped_gyro_data;
-
-uint8_t (*LEDFilter::p_virtual_leds)[3] = virtual_leds;
-uint8_t (*LEDFilter::p_hsv_virtual_leds)[3] = hsv_virtual_leds;
-
-
-/* Power toggle flag */
-volatile bool flag_toggle_system_power = false;
-volatile bool is_system_on = true;
-
-void process_data ();
+void process_data (uint32_t sample_sys);
 
 int main(void) {
     int result;
+    uint32_t sample_sys = 0;
 
     /* Initialize components */
+    if ((result = trace_log_init()) == -1) {
+        LOG_ERROR("Trace log init failed.");
+    }
+
     if ((result = led_strip_init(NUM_PIXELS)) == -1) {
         LOG_ERROR("LED init failed.");
     } else {
@@ -64,6 +50,10 @@ int main(void) {
         LOG_DEBUG("ICM init succeeded.");
     }
 
+    if ((result = wheel_phase_init()) == -1) {
+        LOG_ERROR("Wheel phase init failed.");
+    }
+
     if ((result = button_init(GPIO_PUSH_BTN_1, mode_button_irq_function)) == -1) {
         LOG_ERROR("Mode button init failed.");
     } else {
@@ -76,53 +66,146 @@ int main(void) {
         LOG_DEBUG("Power button init succeeded.");
     }
 
-    uint32_t last_execution_time = 0;
+    if ((result = frame_scheduler_init(FRAME_RATE_FPS, LED_STRIP_DITHER_SUBFRAMES)) == -1) {
+        LOG_ERROR("Frame scheduler init failed.");
+    }
 
-    while (1) {
-        uint32_t current_time = osKernelGetTickCount();
-        uint32_t elapsed_time = current_time - last_execution_time;
+    profiler_init();
 
-        // Check if it's time to execute the next frame
-        if (elapsed_time >= FRAME_TIME_MS) {
-            last_execution_time = current_time;
+    if ((result = power_state_init()) == -1) {
+        LOG_ERROR("Power state init failed.");
+    }
 
+    /* Started last, so the init above does not count against the stage deadlines. */
+    watchdog_register(WATCHDOG_STAGE_SENSORS, WATCHDOG_STAGE_DEADLINE_MS);
+    watchdog_register(WATCHDOG_STAGE_RENDER, WATCHDOG_STAGE_DEADLINE_MS);
+    watchdog_register(WATCHDOG_STAGE_OUTPUT, WATCHDOG_STAGE_DEADLINE_MS);
+    if ((result = watchdog_init()) == -1) {
+        LOG_ERROR("Watchdog init failed.");
+    }
 
-            if (!is_system_on) {
+#ifdef DEBUG
+    int frames_since_stats_report = 0;
+#endif
 
-                /* Read sensor data */
+    while (1) {
+        /* Sleeps until the next slot, there are LED_STRIP_DITHER_SUBFRAMES slots per frame. */
+        FrameSlot slot = frame_scheduler_wait();
+
+        /* Blocks in the off state until the power button is pressed again, then renders right away. */
+        if (flag_toggle_system_power) {
+            power_off();
+            continue;
+        }
+
+        if (slot == FRAME_SLOT_RENDER) {
+
+            /* Read sensor data */
+            watchdog_begin(WATCHDOG_STAGE_SENSORS);
+            {
+                PROFILE_SCOPE(PROFILE_STAGE_SENSORS);
+                /* The gyro read is issued here, later timestamps would skew the wheel angle. */
+                sample_sys = osKernelGetSysTimerCount();
                 if ((result = icm_20649_read_gyro_data(gyro_data)) == -1) {
                     LOG_ERROR("icm_20649_read_gyro_data failed.");
                 } else {
-                    LOG_DEBUG("GYRO data: X=%f, Y=%f, Z=%f\n", gyro_data[0], gyro_data[1], gyro_data[2]);
+                    TRACE_DEBUG("GYRO data: X=%f, Y=%f, Z=%f\n", gyro_data[0], gyro_data[1], gyro_data[2]);
                 }
 
                 if ((result = icm_20649_read_accel_data(accel_data)) == -1) {
                     LOG_ERROR("icm_20649_read_accel_data failed.");
                 } else {
-                    LOG_DEBUG("Accelerometer data: X=%f, Y=%f, Z=%f\n", accel_data[0], accel_data[1], accel_data[2]);
+                    TRACE_DEBUG("Accelerometer data: X=%f, Y=%f, Z=%f\n", accel_data[0], accel_data[1], accel_data[2]);
                 }
+            }
 
-                /* Process sensor data into useful values. Available to all LED_Filters */
-                process_data();
-
+            watchdog_checkin(WATCHDOG_STAGE_SENSORS);
 
-                /* Apply the current filter as determined by the filter handler. */
-                call_current_led_filter();
+            /* Process sensor data into useful values. Available to all LED_Filters */
+            watchdog_begin(WATCHDOG_STAGE_RENDER);
+            {
+                PROFILE_SCOPE(PROFILE_STAGE_PROCESS);
+                process_data(sample_sys);
+            }
 
-                /* Push LED values created inside the LED_filter to the LEDs */
-                set_leds(virtual_leds);
-                update_leds();
+            /* Apply the current filter as determined by the filter handler, it renders straight into the driver's frame. */
+            {
+                PROFILE_SCOPE(PROFILE_STAGE_FILTER);
+                set_led_filter_quality(frame_scheduler_get_quality());
+                call_current_led_filter(led_strip_frame());
             }
 
-            /* When the flag is set, clear LEDs and toggle system power so above functions in while loop are skipped. */
-            if (flag_toggle_system_power) {
-                clear_leds(virtual_leds);
-                update_leds();
-                toggle_power();
-                flag_toggle_system_power = false;
+            /* A filter that renders in every slot, e.g. POV, gets its slots from the next frame on. */
+            int subframes = current_led_filter_subframes();
+            frame_scheduler_set_subframes(subframes > 0 ? subframes : LED_STRIP_DITHER_SUBFRAMES);
 
+            /* Push the LED values created inside the LED_filter to the LEDs */
+            {
+                PROFILE_SCOPE(PROFILE_STAGE_ENCODE);
+                led_strip_submit_frame();
+            }
+            watchdog_checkin(WATCHDOG_STAGE_RENDER);
 
+            watchdog_begin(WATCHDOG_STAGE_OUTPUT);
+            {
+                PROFILE_SCOPE(PROFILE_STAGE_OUTPUT);
+                update_leds();
             }
+            watchdog_checkin(WATCHDOG_STAGE_OUTPUT);
+            power_frame_shown();
+
+            /* Only fed when all stages above checked in. */
+            watchdog_feed();
+
+#ifdef DEBUG
+            /* Report what the driver's dirty tracking saved for the current filter. */
+            if (++frames_since_stats_report >= LED_STRIP_STATS_REPORT_FRAMES) {
+                struct led_strip_stats stats;
+                led_strip_get_stats(&stats);
+                LOG_DEBUG("LED stats mode %s: encoded %lu/%lu pixels, skipped %lu/%lu transfers",
+                          led_filter_name(current_state),
+                          (unsigned long) stats.pixels_encoded,
+                          (unsigned long) (stats.pixels_encoded + stats.pixels_skipped),
+                          (unsigned long) stats.transfers_skipped,
+                          (unsigned long) (stats.transfers + stats.transfers_skipped));
+                LOG_DEBUG("LED current %lu mA at %lu%% brightness, peak request %lu mA, %lu frames limited",
+                          (unsigned long) stats.current_ma,
+                          (unsigned long) ((stats.brightness * 100U) >> 16),
+                          (unsigned long) stats.peak_request_ma,
+                          (unsigned long) stats.limited_frames);
+
+                struct frame_scheduler_stats frame_stats;
+                frame_scheduler_get_stats(&frame_stats);
+                LOG_DEBUG("Frame rate %lu.%02lu fps, %lu late slots, %lu deadline misses up to %lu us, quality %d",
+                          (unsigned long) (frame_stats.fps_x100 / 100),
+                          (unsigned long) (frame_stats.fps_x100 % 100),
+                          (unsigned long) frame_stats.late_slots,
+                          (unsigned long) frame_stats.deadline_misses,
+                          (unsigned long) frame_stats.max_overrun_us,
+                          frame_stats.quality);
+                struct trace_log_stats trace_stats;
+                trace_log_get_stats(&trace_stats);
+                LOG_DEBUG("Trace log %lu entries, %lu dropped, ring peak %lu/%d",
+                          (unsigned long) trace_stats.written,
+                          (unsigned long) trace_stats.dropped,
+                          (unsigned long) trace_stats.max_used,
+                          TRACE_LOG_RING_ENTRIES);
+                profiler_report();
+                led_strip_reset_stats();
+                frames_since_stats_report = 0;
+            }
+#endif
+        } else {
+            /* Between render ticks, filters that render in subframes render again, the
+             * others re-send the frame with the next dither step. */
+            watchdog_begin(WATCHDOG_STAGE_OUTPUT);
+            if (call_current_led_filter_subframe(led_strip_frame())) {
+                led_strip_submit_frame();
+            } else {
+                led_strip_dither();
+            }
+            update_leds();
+            watchdog_checkin(WATCHDOG_STAGE_OUTPUT);
         }
 
 
@@ -137,12 +220,16 @@ int main(void) {
  *
  * Description:
  * The mapped values are fed with the smoothing values, not the raw accelerometer data.
+ * sample_sys is the system timer count at which the gyro read was issued.
  *
  * */
 
 
 
-void process_data (){
+void process_data (uint32_t sample_sys){
+    /* The wheel angle integrates the raw gyro, smoothing would delay it. */
+    wheel_phase_update(gyro_data, accel_data, sample_sys);
+
     /* The smoothing function blends the new value with the previous. The higher the smoothing_factor,
      * the more weight that is given to the previous value. */
     for (int i = 0; i < 3; i++) {
@@ -0,0 +1,101 @@
+/*
+ * File: particles.cpp
+ * Description:
+ * Freeing a particle moves the last live particle into its slot, so the live
+ * particles stay packed and the order of the pool changes. Rendering adds all
+ * particles into a 16-bit light buffer first and saturates once per pixel, so the
+ * result does not depend on that order.
+ */
+
+#include <string.h>
+#include "particles.h"
+#include "utils/hsv_to_rgb.h"
+
+// A pixel adds at most 255 per particle, the light buffer cannot overflow.
+static_assert(PARTICLE_POOL_CAPACITY * 255 <= UINT16_MAX, "particle light buffer too small for the pool");
+
+// Shared by all pools, only used within particle_pool_render()
+static uint16_t particle_light[NUM_PIXELS][3];
+
+
+void particle_pool_init(struct particle_pool *pool) {
+    pool->count = 0;
+    pool->dropped = 0;
+}
+
+
+struct particle *particle_spawn(struct particle_pool *pool) {
+    if (pool->count >= PARTICLE_POOL_CAPACITY) {
+        pool->dropped++;
+        return NULL;
+    }
+    return &pool->particles[pool->count++];
+}
+
+
+void particle_pool_update(struct particle_pool *pool, int num_pixels) {
+    int32_t limit = PARTICLE_PIXELS(num_pixels);
+    int i = 0;
+
+    while (i < pool->count) {
+        struct particle *p = &pool->particles[i];
+
+        if (p->life <= p->decay) {
+            *p = pool->particles[--pool->count];
+            continue;
+        }
+        p->life -= p->decay;
+
+        p->position += p->velocity;
+        if (p->position < 0 || p->position >= limit) {
+            p->position %= limit;
+            if (p->position < 0) {
+                p->position += limit;
+            }
+        }
+        i++;
+    }
+}
+
+
+/********************************************//**
+ *  Adds weight / 256 of the colour to a pixel.
+ ***********************************************/
+static inline void add_light(int pixel, uint8_t red, uint8_t green, uint8_t blue, uint32_t weight) {
+    particle_light[pixel][0] += (uint16_t) ((red * weight) >> 8);
+    particle_light[pixel][1] += (uint16_t) ((green * weight) >> 8);
+    particle_light[pixel][2] += (uint16_t) ((blue * weight) >> 8);
+}
+
+static inline uint8_t saturate(uint16_t light) {
+    return (uint8_t) (light > 255 ? 255 : light);
+}
+
+
+void particle_pool_render(const struct particle_pool *pool, FrameBuffer *frame, bool antialias) {
+    const int num_pixels = frame->num_pixels;
+    memset(particle_light, 0, sizeof(particle_light[0]) * num_pixels);
+
+    for (int i = 0; i < pool->count; i++) {
+        const struct particle *p = &pool->particles[i];
+        uint8_t red, green, blue;
+        hsv_to_rgb(p->hue, 255, (uint8_t) (p->life >> PARTICLE_LIFE_BITS), red, green, blue);
+
+        if (antialias) {
+            int pixel = p->position >> PARTICLE_POSITION_BITS;
+            int next = pixel + 1 < num_pixels ? pixel + 1 : 0;
+            uint32_t fraction = (uint32_t) (p->position >> (PARTICLE_POSITION_BITS - 8)) & 0xFF;
+
+            add_light(pixel, red, green, blue, 256 - fraction);
+            add_light(next, red, green, blue, fraction);
+        } else {
+            int pixel = (p->position + PARTICLE_PIXELS(0.5)) >> PARTICLE_POSITION_BITS;
+            add_light(pixel < num_pixels ? pixel : 0, red, green, blue, 256);
+        }
+    }
+
+    for (int i = 0; i < num_pixels; i++) {
+        frame_buffer_set_rgb(frame, i, saturate(particle_light[i][0]), saturate(particle_light[i][1]),
+                             saturate(particle_light[i][2]));
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * File: particles.h
+ * Description: Fixed-capacity pool of light particles moving along the strip.
+ *
+ * A particle has a position and velocity in pixels, a hue, and a life that is its
+ * brightness and drops by its decay every frame. All values are fixed point. The
+ * pool is a plain array of PARTICLE_POOL_CAPACITY particles with the live ones
+ * packed at the front, so spawning and freeing are O(1), updating walks only live
+ * particles, and nothing is allocated after the pool is initialised. Rendering
+ * adds the particles up with sub-pixel anti-aliasing, a particle between two
+ * pixels lights both in proportion to its distance.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "globals.h"
+#include "ws2812b/frame_buffer.h"
+
+#define PARTICLE_POSITION_BITS (16) // fraction bits of position and velocity, Q16.16 pixels
+#define PARTICLE_LIFE_BITS (8)      // fraction bits of life and decay, Q8.8 brightness
+
+#define PARTICLE_PIXELS(pixels) ((int32_t) ((pixels) * (1 << PARTICLE_POSITION_BITS)))
+#define PARTICLE_LIFE_FULL ((uint16_t) (255U << PARTICLE_LIFE_BITS))
+
+struct particle {
+    int32_t position;   // Q16.16 pixels, wraps around the strip
+    int32_t velocity;   // Q16.16 pixels per frame
+    uint16_t life;      // Q8.8 brightness, the particle is freed when it reaches 0
+    uint16_t decay;     // Q8.8 brightness lost per frame
+    uint8_t hue;
+};
+
+struct particle_pool {
+    struct particle particles[PARTICLE_POOL_CAPACITY];
+    int count;          // live particles, they are particles[0 .. count - 1]
+    uint32_t dropped;   // spawns refused because the pool was full
+};
+
+void particle_pool_init(struct particle_pool *pool);
+
+/**
+ * @brief Takes a particle from the pool.
+ *
+ * @return The particle, to be filled in by the caller, or NULL if the pool is full.
+ */
+struct particle *particle_spawn(struct particle_pool *pool);
+
+/**
+ * @brief Moves every particle by its velocity, wrapping around num_pixels, and
+ * decays it. Particles whose life runs out go back to the pool.
+ */
+void particle_pool_update(struct particle_pool *pool, int num_pixels);
+
+/**
+ * @brief Renders the particles into frame, over black. Overlapping particles add up
+ * and saturate.
+ *
+ * @param antialias Split each particle over the two pixels it lies between. When
+ * false each particle lights the nearest pixel only, which is cheaper.
+ */
+void particle_pool_render(const struct particle_pool *pool, FrameBuffer *frame, bool antialias);
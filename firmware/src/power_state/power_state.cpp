@@ -0,0 +1,163 @@
+/*
+ * File: power_state.cpp
+ * Description:
+ * The off state is entered by the main loop, never from the IRQ, so the strip is
+ * not cut off in the middle of a transfer. power_off() runs the whole off period:
+ * it powers the peripherals down, waits on a thread flag, and powers them up again
+ * when the power button IRQ sets the flag. While the main thread waits there is no
+ * other work, the frame scheduler's idle sleep hook lets the kernel sleep and the
+ * GPIO interrupt of the button wakes it. That is the kernel's idle sleep, not EM4:
+ * RAM and the driver state are kept, so the way back needs no reinitialization.
+ *
+ * The resume latency runs from the button interrupt to the end of the first frame
+ * after it. It is measured with the system timer and checked against
+ * POWER_RESUME_BUDGET_US, together with the part of it spent bringing the LED rail
+ * and the ICM back, which must not block: the ICM wake is a single I2C write.
+ */
+
+#include "power_state.h"
+#include "kernel.h"
+#include "logging.h"
+#include "globals.h"
+#include "ws2812b/ws2812b.h"
+#include "icm20649/icm20649.h"
+#include "frame_scheduler/frame_scheduler.h"
+#include "watchdog/watchdog.h"
+
+LOG_MODULE(power_state)
+
+#define POWER_FLAG_WAKE (1U << 0)
+
+volatile bool flag_toggle_system_power = false;
+
+static PowerState g_power_state = POWER_STATE_ON;
+static osThreadId_t g_main_thread = NULL;
+static volatile uint32_t g_last_press_tick;
+static volatile uint32_t g_wake_sys;    // system timer count of the press that woke the system
+static uint32_t g_woken_sys;            // system timer count when the peripherals were back on
+static bool g_resume_pending = false;   // the first frame after a wake is not shown yet
+static struct power_state_stats g_stats;
+
+
+int power_state_init() {
+    g_main_thread = osThreadGetId();
+    if (g_main_thread == NULL) {
+        LOG_ERROR("Power state init has no thread to wake.");
+        return -1;
+    }
+    g_last_press_tick = osKernelGetTickCount();
+    return 0;
+}
+
+
+/**
+ * @brief Handles a power button press.
+ *
+ * Presses within POWER_BUTTON_DEBOUNCE_MS of the last one are contact bounce
+ * and ignored. In the off state the press also wakes the main thread.
+ */
+void power_button_pressed() {
+    uint32_t now = osKernelGetTickCount();
+    uint32_t debounce_ticks = (POWER_BUTTON_DEBOUNCE_MS * osKernelGetTickFreq()) / 1000U;
+
+    if (now - g_last_press_tick < debounce_ticks) {
+        return;
+    }
+    g_last_press_tick = now;
+    g_wake_sys = osKernelGetSysTimerCount();
+    flag_toggle_system_power = true;
+
+    if (g_main_thread != NULL) {
+        osThreadFlagsSet(g_main_thread, POWER_FLAG_WAKE);
+    }
+}
+
+
+/**
+ * @brief Powers the system down and blocks until the power button is pressed again.
+ *
+ * The strip is cleared and latched first, so the LEDs do not come up with the
+ * last frame when the rail returns. On the way back the frame scheduler starts
+ * over, so the first frame is rendered right away.
+ */
+void power_off() {
+    clear_leds();
+    update_leds();
+    if (led_strip_power(false) == -1) {
+        LOG_ERROR("Failed to switch the LED rail off.");
+    }
+    if (icm_20649_sleep() == -1) {
+        LOG_ERROR("Failed to put the ICM to sleep.");
+    }
+
+    g_power_state = POWER_STATE_OFF;
+    flag_toggle_system_power = false;
+    LOG_DEBUG("Power off.");
+
+    /* Neither watchdog may bite while the thread waits for the button. */
+    watchdog_suspend();
+    osWatchdogSuspendForThread();
+
+    /* A press that came in while powering down must not count as the wake. */
+    osThreadFlagsClear(POWER_FLAG_WAKE);
+    while (!flag_toggle_system_power) {
+        osThreadFlagsWait(POWER_FLAG_WAKE, osFlagsWaitAny, osWaitForever);
+    }
+
+    osWatchdogResumeForThread();
+
+    if (led_strip_power(true) == -1) {
+        LOG_ERROR("Failed to switch the LED rail on.");
+    }
+    if (icm_20649_wake() == -1) {
+        LOG_ERROR("Failed to wake the ICM.");
+    }
+    g_woken_sys = osKernelGetSysTimerCount();
+
+    g_power_state = POWER_STATE_ON;
+    flag_toggle_system_power = false;
+    g_resume_pending = true;
+    g_stats.power_cycles++;
+    frame_scheduler_restart();
+    watchdog_resume();
+}
+
+
+/**
+ * @brief Measures the resume latency once the first frame after a wake is sent.
+ */
+void power_frame_shown() {
+    if (!g_resume_pending) {
+        return;
+    }
+    g_resume_pending = false;
+
+    uint32_t freq = osKernelGetSysTimerFreq();
+    uint32_t elapsed = osKernelGetSysTimerCount() - g_wake_sys;
+    uint32_t resume_us = (uint32_t) (((uint64_t) elapsed * 1000000U) / freq);
+    uint32_t wake_us = (uint32_t) (((uint64_t) (g_woken_sys - g_wake_sys) * 1000000U) / freq);
+
+    g_stats.last_resume_us = resume_us;
+    g_stats.last_wake_us = wake_us;
+    if (resume_us > g_stats.max_resume_us) {
+        g_stats.max_resume_us = resume_us;
+    }
+
+    if (resume_us > POWER_RESUME_BUDGET_US) {
+        LOG_WARNING("Power on took %lu us to the first frame (%lu us to wake the peripherals), budget is %lu us.",
+                    (unsigned long) resume_us, (unsigned long) wake_us, (unsigned long) POWER_RESUME_BUDGET_US);
+    } else {
+        LOG_DEBUG("Power on, first frame after %lu us (%lu us to wake the peripherals).",
+                  (unsigned long) resume_us, (unsigned long) wake_us);
+    }
+}
+
+
+PowerState power_state_get() {
+    return g_power_state;
+}
+
+
+void power_state_get_stats(struct power_state_stats *stats) {
+    *stats = g_stats;
+}
@@ -0,0 +1,32 @@
+/*
+ * File: power_state.h
+ * Description: Switches the system between on and a real off state. Off clears
+ * and latches the strip, cuts the LED rail, puts the ICM to sleep and parks the
+ * main thread until the power button is pressed, so the kernel sleeps instead of
+ * polling.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// Enum to define the power states of the system.
+typedef enum {
+    POWER_STATE_ON,     // rendering frames
+    POWER_STATE_OFF,    // LED rail and sensor off, main thread waits for the power button
+} PowerState;
+
+struct power_state_stats {
+    uint32_t power_cycles;          // times the system was switched off and on again
+    uint32_t last_resume_us;        // power button press to first frame, last resume
+    uint32_t last_wake_us;          // power button press to the LED rail and ICM back on, part of last_resume_us
+    uint32_t max_resume_us;         // longest resume since init
+};
+
+extern volatile bool flag_toggle_system_power;  // set by the power button, handled by the main loop
+
+int  power_state_init();                                // Call from the main thread, which is the one that sleeps
+void power_button_pressed();                            // Call from the power button IRQ
+void power_off();                                       // Blocks in the off state until the power button wakes the system
+void power_frame_shown();                               // Call after each frame is sent, measures the resume latency
+PowerState power_state_get();
+void power_state_get_stats(struct power_state_stats *stats);
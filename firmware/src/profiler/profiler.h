@@ -0,0 +1,57 @@
+/*
+ * File: profiler.h
+ * Description: Cycle counts of the stages of a frame.
+ *
+ * Wrap a stage in PROFILE_SCOPE() and every pass through it is recorded in a fixed
+ * histogram. profiler_report() logs min/avg/p99/max per stage and starts over.
+ * On the target the DWT cycle counter is used, a host build measures in ns with
+ * clock_gettime(). Only debug builds with PROFILE_FRAME_STAGES defined in globals.h
+ * contain the profiler, otherwise every call compiles to nothing.
+ */
+#pragma once
+#include <stdint.h>
+#include "globals.h"
+
+// Enum to define the profiled stages of a frame.
+typedef enum {
+    PROFILE_STAGE_SENSORS,      // icm_20649_read_gyro_data() and icm_20649_read_accel_data()
+    PROFILE_STAGE_PROCESS,      // process_data()
+    PROFILE_STAGE_FILTER,       // call_current_led_filter()
+    PROFILE_STAGE_ENCODE,       // led_strip_submit_frame()
+    PROFILE_STAGE_OUTPUT,       // update_leds()
+    PROFILE_STAGE_MAX_VALUE
+} ProfileStage;
+
+#if defined(DEBUG) && defined(PROFILE_FRAME_STAGES)
+#define PROFILER_ENABLED
+#endif
+
+#ifdef PROFILER_ENABLED
+
+void profiler_init();                                     // Starts the cycle counter
+uint32_t profiler_now();                                  // Current cycle count
+void profiler_record(ProfileStage stage, uint32_t cycles);
+void profiler_report();                                   // Logs one line per stage and clears the histograms
+
+/**
+ * @brief Records the cycles from its construction to the end of the enclosing scope.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileStage stage) : stage(stage), start(profiler_now()) {}
+    ~ProfileScope() { profiler_record(stage, profiler_now() - start); }
+
+private:
+    ProfileStage stage;
+    uint32_t start;
+};
+
+#define PROFILE_SCOPE(stage) ProfileScope profile_scope_##stage(stage)
+
+#else
+
+static inline void profiler_init() {}
+static inline void profiler_report() {}
+#define PROFILE_SCOPE(stage)
+
+#endif
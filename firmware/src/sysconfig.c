@@ -3,16 +3,18 @@
  * Author: Andrew Klenzman
  * Date:
  * Description: This file contains the configuration of the SPI and
- * i2c icm20649.
+ * i2c icm20649, and the layout of the LED strips.
  * Deficiencies:
  */
 
 #include <sysconfig.h>
 #include "globals.h"
+#include "ws2812b/ws2812b.h"
 
 
 sysconf_use_driver(spi_gecko)
 sysconf_use_driver(i2c_gecko)
+sysconf_use_driver(timer_gecko)
 
 
 sysconf_create_device("silabs-gecko-spi", spi0, SPI_MEMORY_MAPPED_ADDRESS,
@@ -23,9 +25,40 @@ sysconf_create_device("silabs-gecko-spi", spi0, SPI_MEMORY_MAPPED_ADDRESS,
 //                      sysconf_set_int_param (gpio_cs, 200)
 )
 
+/* One-shot timer that times the WS2812B reset gap after each frame */
+sysconf_create_device("silabs-gecko-timer", tim0, LATCH_TIMER_MEMORY_MAPPED_ADDRESS,
+                      sysconf_set_int_param (mode, 0), // TIMER_MODE_COUNT
+)
+
+/* Watchdog of the frame stages, see watchdog/watchdog.cpp. The wdt_gecko driver is built into the
+ * kernel, whose thread watchdog uses WDOG0 as device "wdt". */
+sysconf_create_device("silabs-gecko-wdt", wdt1, WATCHDOG_MEMORY_MAPPED_ADDRESS,
+                      sysconf_set_int_param (period_ms, WATCHDOG_PERIOD_MS),
+)
+
+/* A second strip needs its own SPI device, e.g. on EUSART1, and an entry in led_strip_layout.
+sysconf_create_device("silabs-gecko-spi", spi1, EUSART1_MEMORY_MAPPED_ADDRESS,
+                      sysconf_set_int_param (gpio_mosi, SPI1_GPIO_MOSI),
+                      sysconf_set_int_param (gpio_clk, SPI1_GPIO_CLOCK),
+                      sysconf_set_int_param (baudrate, SPI_BAUDRATE),
+)
+*/
+
 
 sysconf_create_device("silabs-gecko-i2c", i2c1, I2C_MEMORY_MAPPED_ADDRESS,
                       sysconf_set_int_param (gpio_scl, I2C_CLOCK),
                       sysconf_set_int_param (gpio_sda, I2C_DATA_IN),
                       sysconf_set_int_param (baudrate, I2C_BAUDRATE), //400 kHz
-                      )
\ No newline at end of file
+                      )
+
+
+/* LED strips in the order their pixels appear in the frame. The pixel counts must add up to NUM_PIXELS.
+ * Each strip is driven by its own SPI device, and the transfers of all strips overlap.
+ * The SPI baudrate of a strip has to suit its chipset: SPI_BAUDRATE for WS2812B, SK6812_SPI_BAUDRATE
+ * for SK6812 RGBW and APA102_SPI_BAUDRATE for APA102/SK9822. */
+const struct led_strip_config led_strip_layout[] = {
+        {"spi0", NUM_PIXELS, &led_protocol_ws2812b},
+//        {"spi1", 25, &led_protocol_apa102},
+};
+
+const int led_strip_layout_count = sizeof(led_strip_layout) / sizeof(led_strip_layout[0]);
@@ -0,0 +1,212 @@
+/*
+ * File: trace_log.cpp
+ * Description:
+ * The ring holds TRACE_LOG_RING_ENTRIES fixed size entries. Writers reserve an
+ * entry by advancing the head with a compare-and-swap, fill it, and publish it by
+ * storing its sequence number last. Threads and IRQs may write at the same time,
+ * nothing takes a lock. The single reader formats entries in order and waits for
+ * an entry that is reserved but not published yet. A full ring drops the new
+ * entry and counts it, the reader reports the count.
+ *
+ * Formatting walks the format string and prints one conversion at a time with
+ * snprintf(), cast to the type the argument was stored as. Length modifiers are
+ * dropped since every argument is a 32-bit word or a float.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include "trace_log.h"
+#include "kernel.h"
+
+LOG_MODULE(trace_log)
+
+#define TRACE_LOG_LINE_LENGTH (160)
+#define TRACE_LOG_SPEC_LENGTH (16)
+#define TRACE_LOG_THREAD_STACK_SIZE (1536) // snprintf() of floats needs about 1 KB
+
+static_assert((TRACE_LOG_RING_ENTRIES & (TRACE_LOG_RING_ENTRIES - 1)) == 0, "TRACE_LOG_RING_ENTRIES must be a power of two");
+
+struct trace_log_entry {
+    const struct trace_log_format *format;
+    uint32_t tick;
+    uint32_t types;
+    uint32_t args[TRACE_LOG_MAX_ARGS];
+    volatile uint32_t sequence;     // head value of the reservation plus one once the entry is complete
+};
+
+static struct trace_log_entry g_ring[TRACE_LOG_RING_ENTRIES];
+static uint32_t g_head = 0;             // next entry to reserve
+static uint32_t g_tail = 0;             // next entry to format, only the reader moves it
+static uint32_t g_dropped = 0;
+static uint32_t g_reported_dropped = 0;
+static uint32_t g_max_used = 0;
+static osThreadId_t g_thread = NULL;
+
+
+void trace_log_push(const struct trace_log_format *format, uint32_t types, const uint32_t *args, int count) {
+    uint32_t head = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+
+    do {
+        if (head - __atomic_load_n(&g_tail, __ATOMIC_ACQUIRE) >= TRACE_LOG_RING_ENTRIES) {
+            __atomic_fetch_add(&g_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&g_head, &head, head + 1, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    struct trace_log_entry *entry = &g_ring[head & (TRACE_LOG_RING_ENTRIES - 1)];
+    entry->format = format;
+    entry->tick = osKernelGetTickCount();
+    entry->types = types;
+    for (int i = 0; i < count; i++) {
+        entry->args[i] = args[i];
+    }
+    __atomic_store_n(&entry->sequence, head + 1, __ATOMIC_RELEASE);
+}
+
+
+/********************************************//**
+ *  Prints one conversion of the format string
+ *  with the stored argument word. Returns the
+ *  characters written, like snprintf().
+ ***********************************************/
+static int trace_log_format_arg(char *out, size_t size, const char *spec, char conversion, uint32_t type, uint32_t word) {
+    switch (conversion) {
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            float value;
+            if (type == TRACE_ARG_FLOAT) {
+                memcpy(&value, &word, sizeof(value));
+            } else {
+                value = type == TRACE_ARG_INT ? (float) (int32_t) word : (float) word;
+            }
+            return snprintf(out, size, spec, (double) value);
+        }
+        case 's':
+            return snprintf(out, size, spec, (const char *) (uintptr_t) word);
+        case 'p':
+            return snprintf(out, size, spec, (void *) (uintptr_t) word);
+        case 'd': case 'i': case 'c':
+            return snprintf(out, size, spec, (int) (int32_t) word);
+        default:
+            return snprintf(out, size, spec, (unsigned int) word);
+    }
+}
+
+
+/********************************************//**
+ *  Formats an entry into a line the way printf()
+ *  would have at the call site.
+ ***********************************************/
+static void trace_log_format_entry(char *line, size_t size, const struct trace_log_entry *entry) {
+    const char *fmt = entry->format->fmt;
+    size_t length = 0;
+    int arg = 0;
+
+    while (*fmt != '\0' && length + 1 < size) {
+        if (*fmt != '%') {
+            line[length++] = *fmt++;
+            continue;
+        }
+        if (fmt[1] == '%') {
+            line[length++] = '%';
+            fmt += 2;
+            continue;
+        }
+
+        /* Copy flags, width and precision, skip length modifiers. */
+        char spec[TRACE_LOG_SPEC_LENGTH];
+        size_t spec_length = 0;
+        spec[spec_length++] = *fmt++;
+        while (*fmt != '\0' && strchr("-+ #0123456789.", *fmt) != NULL) {
+            if (spec_length < sizeof(spec) - 2) {
+                spec[spec_length++] = *fmt;
+            }
+            fmt++;
+        }
+        while (*fmt != '\0' && strchr("hlLqjzt", *fmt) != NULL) {
+            fmt++;
+        }
+        if (*fmt == '\0') {
+            break;
+        }
+        char conversion = *fmt++;
+        spec[spec_length++] = conversion;
+        spec[spec_length] = '\0';
+
+        if (arg >= TRACE_LOG_MAX_ARGS) {
+            break;
+        }
+        uint32_t type = (entry->types >> (arg * TRACE_ARG_TYPE_BITS)) & ((1U << TRACE_ARG_TYPE_BITS) - 1);
+        int written = trace_log_format_arg(line + length, size - length, spec, conversion, type, entry->args[arg]);
+        arg++;
+        if (written > 0) {
+            length += (size_t) written < size - length ? (size_t) written : size - length - 1;
+        }
+    }
+    line[length] = '\0';
+}
+
+
+void trace_log_flush() {
+    static char line[TRACE_LOG_LINE_LENGTH];
+    uint32_t tail = g_tail;
+    uint32_t used = __atomic_load_n(&g_head, __ATOMIC_ACQUIRE) - tail;
+
+    if (used > g_max_used) {
+        g_max_used = used;
+    }
+
+    while (true) {
+        struct trace_log_entry *entry = &g_ring[tail & (TRACE_LOG_RING_ENTRIES - 1)];
+        if (__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) != tail + 1) {
+            break;  // empty, or the next entry is still being written
+        }
+
+        const struct trace_log_format *format = entry->format;
+        trace_log_format_entry(line, sizeof(line), entry);
+        uint32_t tick = entry->tick;
+        tail++;
+        __atomic_store_n(&g_tail, tail, __ATOMIC_RELEASE);
+
+        cw_log_prepare_formatting(format->level);
+        cw_log_prefix(format->level, *format->module);
+        cw_log_output("@%lu %s", (unsigned long) tick, line);
+        cw_log_cleanup(1);
+    }
+
+    uint32_t dropped = __atomic_load_n(&g_dropped, __ATOMIC_RELAXED);
+    if (dropped != g_reported_dropped) {
+        LOG_WARNING("%lu trace log entries dropped, the ring is full.", (unsigned long) (dropped - g_reported_dropped));
+        g_reported_dropped = dropped;
+    }
+}
+
+
+static void trace_log_thread(void *argument) {
+    while (1) {
+        osDelay(TRACE_LOG_FLUSH_MS);
+        trace_log_flush();
+    }
+}
+
+
+int trace_log_init() {
+    osThreadAttr_t attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.name = "trace_log";
+    attr.stack_size = TRACE_LOG_THREAD_STACK_SIZE;
+    attr.priority = osPriorityLow;
+
+    g_thread = osThreadNew(trace_log_thread, NULL, &attr);
+    if (g_thread == NULL) {
+        LOG_ERROR("Failed to start the trace log thread.");
+        return -1;
+    }
+    return 0;
+}
+
+
+void trace_log_get_stats(struct trace_log_stats *stats) {
+    stats->written = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&g_dropped, __ATOMIC_RELAXED);
+    stats->max_used = g_max_used;
+}
@@ -0,0 +1,97 @@
+/*
+ * File: trace_log.h
+ * Description: Deferred logging for the hot path.
+ *
+ * TRACE_DEBUG() and the other macros take the arguments of LOG_DEBUG(), but the
+ * call site only stores the address of its format record and the raw arguments
+ * in a RAM ring. A low priority thread formats the entries and hands them to the
+ * ColdwaveOS log output, so no printf runs inside a frame. The address of the
+ * format record is its ID: a host tool can resolve it from the ELF and format a
+ * ring dump offline.
+ *
+ * Calls above TRACE_LOG_LEVEL (globals.h) compile to nothing. Up to
+ * TRACE_LOG_MAX_ARGS integer, float or pointer arguments are stored as 32-bit
+ * words, doubles are narrowed to float. A %s argument is formatted later, so it
+ * must point to a string that stays valid, e.g. a literal.
+ */
+#pragma once
+#include <stdint.h>
+#include <type_traits>
+#include "logging.h"
+#include "globals.h"
+
+#define TRACE_LOG_MAX_ARGS (4)
+
+// Enum to define how a stored argument word is formatted.
+typedef enum {
+    TRACE_ARG_INT,
+    TRACE_ARG_UINT,
+    TRACE_ARG_FLOAT,
+    TRACE_ARG_POINTER,
+} TraceArgType;
+
+#define TRACE_ARG_TYPE_BITS (2)
+
+struct trace_log_format {
+    int level;                      // CW_LOGLVL_*
+    const char *const *module;      // the cw_log_module of the call site
+    const char *fmt;
+};
+
+struct trace_log_stats {
+    uint32_t written;       // entries stored by the call sites
+    uint32_t dropped;       // entries lost because the ring was full
+    uint32_t max_used;      // highest ring fill seen by the formatter
+};
+
+int  trace_log_init();                  // Starts the formatter thread, entries written before are kept
+void trace_log_push(const struct trace_log_format *format, uint32_t types, const uint32_t *args, int count);
+void trace_log_flush();                 // Formats all pending entries in the calling thread
+void trace_log_get_stats(struct trace_log_stats *stats);
+
+
+template <typename T>
+static inline uint32_t trace_log_word(T value) {
+    if constexpr (std::is_floating_point<T>::value) {
+        union { float f; uint32_t u; } bits = {(float) value};
+        return bits.u;
+    } else if constexpr (std::is_pointer<T>::value) {
+        return (uint32_t) (uintptr_t) value;
+    } else {
+        return (uint32_t) value;
+    }
+}
+
+template <typename T>
+static constexpr uint32_t trace_log_type() {
+    return std::is_floating_point<T>::value ? TRACE_ARG_FLOAT :
+           std::is_pointer<T>::value ? TRACE_ARG_POINTER :
+           std::is_signed<T>::value ? TRACE_ARG_INT : TRACE_ARG_UINT;
+}
+
+template <typename... Args>
+static constexpr uint32_t trace_log_types() {
+    uint32_t types = 0;
+    int shift = 0;
+    ((types |= trace_log_type<typename std::decay<Args>::type>() << shift, shift += TRACE_ARG_TYPE_BITS), ...);
+    return types;
+}
+
+template <typename... Args>
+static inline void trace_log_write(const struct trace_log_format *format, Args... args) {
+    static_assert(sizeof...(Args) <= TRACE_LOG_MAX_ARGS, "too many arguments for a trace log entry");
+    const uint32_t words[TRACE_LOG_MAX_ARGS + 1] = {trace_log_word(args)...};
+    trace_log_push(format, trace_log_types<Args...>(), words, sizeof...(Args));
+}
+
+#define TRACE_LOG(lvl, fmt, ...) do {                                                   \
+        if constexpr ((lvl) <= TRACE_LOG_LEVEL) {                                       \
+            static const struct trace_log_format trace_log_format_ = {lvl, &cw_log_module, fmt}; \
+            trace_log_write(&trace_log_format_, ##__VA_ARGS__);                         \
+        }                                                                               \
+    } while (0)
+
+#define TRACE_DEBUG(...) TRACE_LOG(CW_LOGLVL_DEBUG, __VA_ARGS__)
+#define TRACE_INFO(...) TRACE_LOG(CW_LOGLVL_INFO, __VA_ARGS__)
+#define TRACE_WARNING(...) TRACE_LOG(CW_LOGLVL_WARNING, __VA_ARGS__)
+#define TRACE_ERROR(...) TRACE_LOG(CW_LOGLVL_ERROR, __VA_ARGS__)
@@ -0,0 +1,141 @@
+/*
+ * File: blend_simd.h
+ * Description: Blend modes of two pixel arrays, four bytes per step.
+ *
+ * On the target the kernels use the DSP SIMD instructions of the Cortex-M33 from
+ * cmsis_gcc.h: __UQADD8 adds four bytes with saturation, __SMLAD does the two
+ * multiplies of a lerp in one instruction and __UXTB16 splits the bytes of a
+ * multiply into 16-bit lanes, which __SMUAD multiplies one at a time. Screen is
+ * a multiply of the inverted bytes. Without the DSP extension, e.g. in a host
+ * build, the same kernels run as plain 32-bit integer code with identical
+ * results. The kernels work on bytes, so they fit every pixel format.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis/cmsis_compiler.h"
+#define BLEND_SIMD_DSP
+#endif
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+// Enum to define how a layer is combined with the pixels below it.
+typedef enum {
+    BLEND_MODE_ALPHA,       // the layer covers the pixels below
+    BLEND_MODE_ADD,         // channels add up, saturating at 255
+    BLEND_MODE_MULTIPLY,    // darkens, black stays black and white is transparent
+    BLEND_MODE_SCREEN,      // brightens, white stays white and black is transparent
+} BlendMode;
+
+
+/* Four byte lerps dst + (src - dst) * weight / 256, weight 0 to 256. */
+static inline uint32_t blend_lerp4(uint32_t dst, uint32_t src, uint32_t weight) {
+#ifdef BLEND_SIMD_DSP
+    const uint32_t weights = (weight << 16) | (256U - weight);
+    uint32_t dst_even = __UXTB16(dst);
+    uint32_t dst_odd = __UXTB16(__ROR(dst, 8));
+    uint32_t src_even = __UXTB16(src);
+    uint32_t src_odd = __UXTB16(__ROR(src, 8));
+
+    /* Each __SMLAD takes the byte of dst and of src from one halfword pair. */
+    uint32_t b0 = __SMLAD(__PKHBT(dst_even, src_even, 16), weights, 0) >> 8;
+    uint32_t b1 = __SMLAD(__PKHBT(dst_odd, src_odd, 16), weights, 0) >> 8;
+    uint32_t b2 = __SMLAD(__PKHTB(src_even, dst_even, 16), weights, 0) >> 8;
+    uint32_t b3 = __SMLAD(__PKHTB(src_odd, dst_odd, 16), weights, 0) >> 8;
+    return b0 | (b1 << 8) | (b2 << 16) | (b3 << 24);
+#else
+    const uint32_t inverse = 256U - weight;
+    uint32_t even = ((dst & 0x00FF00FFU) * inverse + (src & 0x00FF00FFU) * weight) >> 8;
+    uint32_t odd = ((dst >> 8) & 0x00FF00FFU) * inverse + ((src >> 8) & 0x00FF00FFU) * weight;
+    return (even & 0x00FF00FFU) | (odd & 0xFF00FF00U);
+#endif
+}
+
+/* Four byte scales value * weight / 256, weight 0 to 256. */
+static inline uint32_t blend_scale4(uint32_t value, uint32_t weight) {
+    uint32_t even = (((value & 0x00FF00FFU) * weight) >> 8) & 0x00FF00FFU;
+    uint32_t odd = (((value >> 8) & 0x00FF00FFU) * weight) & 0xFF00FF00U;
+    return even | odd;
+}
+
+/* Four byte adds, saturating at 255. */
+static inline uint32_t blend_add4(uint32_t a, uint32_t b) {
+#ifdef BLEND_SIMD_DSP
+    return __UQADD8(a, b);
+#else
+    uint32_t sum = (a & 0x7F7F7F7FU) + (b & 0x7F7F7F7FU);
+    uint32_t top = (a ^ b) & 0x80808080U;
+    uint32_t carry = ((a & b) | (top & sum)) & 0x80808080U;
+    return (sum ^ top) | ((carry >> 7) * 0xFFU);
+#endif
+}
+
+/* Four byte products a * b / 255, rounded. The products are packed into two words of
+ * 16-bit lanes, even and odd bytes, and both lanes of a word are rounded at once. */
+static inline uint32_t blend_multiply4(uint32_t a, uint32_t b) {
+    uint32_t even, odd;
+#ifdef BLEND_SIMD_DSP
+    uint32_t a_even = __UXTB16(a);
+    uint32_t a_odd = __UXTB16(__ROR(a, 8));
+    uint32_t b_even = __UXTB16(b);
+    uint32_t b_odd = __UXTB16(__ROR(b, 8));
+    /* __SMUAD of a masked halfword leaves the product of the other halfword alone. */
+    even = __PKHBT(__SMUAD(a_even, b_even & 0x0000FFFFU), __SMUAD(a_even, b_even & 0xFFFF0000U), 16);
+    odd = __PKHBT(__SMUAD(a_odd, b_odd & 0x0000FFFFU), __SMUAD(a_odd, b_odd & 0xFFFF0000U), 16);
+#else
+    even = ((a & 0xFFU) * (b & 0xFFU)) | ((((a >> 16) & 0xFFU) * ((b >> 16) & 0xFFU)) << 16);
+    odd = (((a >> 8) & 0xFFU) * ((b >> 8) & 0xFFU)) | (((a >> 24) * (b >> 24)) << 16);
+#endif
+    /* p / 255 is (x + (x >> 8)) >> 8 with x = p + 128. A lane stays below 65536. */
+    even += 0x00800080U;
+    odd += 0x00800080U;
+    even += (even >> 8) & 0x00FF00FFU;
+    odd += (odd >> 8) & 0x00FF00FFU;
+    return ((even >> 8) & 0x00FF00FFU) | (odd & 0xFF00FF00U);
+}
+
+static inline uint32_t blend_word(uint32_t dst, uint32_t src, BlendMode mode, uint32_t weight) {
+    switch (mode) {
+        case BLEND_MODE_ADD:
+            return blend_add4(dst, blend_scale4(src, weight));
+        case BLEND_MODE_MULTIPLY:
+            return blend_lerp4(dst, blend_multiply4(dst, src), weight);
+        case BLEND_MODE_SCREEN:
+            return blend_lerp4(dst, ~blend_multiply4(~dst, ~src), weight);
+        default:
+            return blend_lerp4(dst, src, weight);
+    }
+}
+
+/**
+ * @brief Blends src onto dst byte by byte.
+ *
+ * @param weight Opacity of src, 0 leaves dst as it is and 256 applies src fully.
+ */
+static inline void blend_bytes(uint8_t *dst, const uint8_t *src, int bytes, BlendMode mode, uint32_t weight) {
+    int i = 0;
+
+    for (; i + 4 <= bytes; i += 4) {
+        uint32_t d, s;
+        memcpy(&d, dst + i, 4);
+        memcpy(&s, src + i, 4);
+        d = blend_word(d, s, mode, weight);
+        memcpy(dst + i, &d, 4);
+    }
+    if (i < bytes) {
+        uint32_t d = 0, s = 0;
+        memcpy(&d, dst + i, bytes - i);
+        memcpy(&s, src + i, bytes - i);
+        d = blend_word(d, s, mode, weight);
+        memcpy(dst + i, &d, bytes - i);
+    }
+}
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,37 @@
+/*
+ * File: cortex_m33.h
+ * Description: The CMSIS core peripherals of the EFR32MG24, e.g. DWT and CoreDebug.
+ *
+ * core_cm33.h expects the device header to configure it, which ColdwaveOS does not
+ * ship. The values below are those of the EFR32MG24 device header; only the core
+ * exceptions are listed, the peripheral interrupts belong to ColdwaveOS.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef enum IRQn {
+    NonMaskableInt_IRQn     = -14,
+    HardFault_IRQn          = -13,
+    MemoryManagement_IRQn   = -12,
+    BusFault_IRQn           = -11,
+    UsageFault_IRQn         = -10,
+    SecureFault_IRQn        = -9,
+    SVCall_IRQn             = -5,
+    DebugMonitor_IRQn       = -4,
+    PendSV_IRQn             = -2,
+    SysTick_IRQn            = -1,
+} IRQn_Type;
+
+#define __CM33_REV              (0x0004U) // r0p4
+#ifndef __FPU_PRESENT
+#define __FPU_PRESENT           (1U) // set by ColdwaveOS
+#endif
+#define __MPU_PRESENT           (1U)
+#define __SAUREGION_PRESENT     (1U)
+#define __DSP_PRESENT           (1U)
+#define __VTOR_PRESENT          (1U)
+#define __NVIC_PRIO_BITS        (4U)
+#define __Vendor_SysTickConfig  (0U)
+
+#include "cmsis/core_cm33.h"
@@ -1,36 +1,48 @@
-#pragma once
-#include <cstdint>  // For uint8_t
-#include <cmath>
-
-// Function to convert HSV to RGB
-static void hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b) {
-    // Normalize HSV values to [0, 1] range
-    float hue = h / 255.0f;
-    float saturation = s / 255.0f;
-    float value = v / 255.0f;
-
-    // Convert HSV to RGB
-    float c = value * saturation;
-    float x = c * (1.0f - fabs(std::fmod(hue * 6.0f, 2.0f) - 1.0f));
-    float m = value - c;
-
-    float r1, g1, b1;
-
-    if (hue < 1.0f / 6.0f) {
-        r1 = c; g1 = x; b1 = 0;
-    } else if (hue < 2.0f / 6.0f) {
-        r1 = x; g1 = c; b1 = 0;
-    } else if (hue < 3.0f / 6.0f) {
-        r1 = 0; g1 = c; b1 = x;
-    } else if (hue < 4.0f / 6.0f) {
-        r1 = 0; g1 = x; b1 = c;
-    } else if (hue < 5.0f / 6.0f) {
-        r1 = x; g1 = 0; b1 = c;
-    } else {
-        r1 = c; g1 = 0; b1 = x;
-    }
+/*
+ * File: hsv_to_rgb.cpp
+ * Description:
+ * A channel of the saturated colour c (from the hue table) becomes
+ * v * (1 - s * (1 - c)), which is what the float HSV formula computes with
+ * chroma v * s. All three factors are 8-bit fractions of 255, each product is
+ * divided by 255 without a division instruction.
+ */
+
+#include "hsv_to_rgb.h"
+#include "utils/hue_spectrum_table.c"
+
+/* a * b / 255 rounded down, exact for all 8-bit a and b. */
+static inline uint8_t mul_div255(uint32_t a, uint32_t b) {
+    uint32_t product = a * b;
+    return (uint8_t) ((product + 1U + (product >> 8)) >> 8);
+}
+
+static inline uint8_t hsv_channel(uint8_t saturated, uint8_t s, uint8_t v) {
+    return mul_div255(v, 255U - mul_div255(s, 255U - saturated));
+}
+
 
-    r = static_cast<uint8_t>((r1 + m) * 255.0f);
-    g = static_cast<uint8_t>((g1 + m) * 255.0f);
-    b = static_cast<uint8_t>((b1 + m) * 255.0f);
+void hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b) {
+    const uint8_t *saturated = hue_spectrum[h];
+
+    r = hsv_channel(saturated[0], s, v);
+    g = hsv_channel(saturated[1], s, v);
+    b = hsv_channel(saturated[2], s, v);
+}
+
+
+void hsv_to_rgb_n(const uint8_t (*hsv)[3], FrameBuffer *frame, int count) {
+    for (int i = 0; i < count; i++) {
+        uint8_t v = hsv[i][2];
+        if (v == 0) {
+            frame_buffer_set_rgb(frame, i, 0, 0, 0);
+            continue;
+        }
+
+        const uint8_t *saturated = hue_spectrum[hsv[i][0]];
+        uint8_t s = hsv[i][1];
+        frame_buffer_set_rgb(frame, i,
+                             hsv_channel(saturated[0], s, v),
+                             hsv_channel(saturated[1], s, v),
+                             hsv_channel(saturated[2], s, v));
+    }
 }
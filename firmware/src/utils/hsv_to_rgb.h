@@ -0,0 +1,20 @@
+/*
+ * File: hsv_to_rgb.h
+ * Description: Integer HSV to RGB conversion on the spectrum colour wheel.
+ *
+ * Hue, saturation and value are 8 bits each. The hue is looked up in a 256 entry
+ * table of fully saturated colours, saturation and value scale it with 8x8 bit
+ * multiplies. The result is within 1 of the float HSV formula for every input.
+ */
+#pragma once
+#include <stdint.h>
+#include "ws2812b/frame_buffer.h"
+
+void hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b);
+
+/**
+ * @brief Converts count HSV pixels into the first count pixels of frame.
+ *
+ * Pixels with a value of 0 are written black without a conversion.
+ */
+void hsv_to_rgb_n(const uint8_t (*hsv)[3], FrameBuffer *frame, int count);
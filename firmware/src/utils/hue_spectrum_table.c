@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Fully saturated, full value colour of every 8-bit hue on the spectrum (hexcone) colour wheel, red at 0,
+ * green at 85 and blue at 170. Rounded down from the float HSV formula the converter replaced. */
+static const uint8_t hue_spectrum[256][3] = {
+        {255, 0, 0}, {255, 5, 0}, {255, 11, 0}, {255, 17, 0}, {255, 23, 0}, {255, 29, 0}, {255, 35, 0}, {255, 41, 0},
+        {255, 47, 0}, {255, 53, 0}, {255, 59, 0}, {255, 65, 0}, {255, 71, 0}, {255, 77, 0}, {255, 83, 0}, {255, 89, 0},
+        {255, 96, 0}, {255, 102, 0}, {255, 108, 0}, {255, 114, 0}, {255, 120, 0}, {255, 126, 0}, {255, 132, 0}, {255, 138, 0},
+        {255, 144, 0}, {255, 150, 0}, {255, 156, 0}, {255, 162, 0}, {255, 168, 0}, {255, 174, 0}, {255, 180, 0}, {255, 186, 0},
+        {255, 192, 0}, {255, 198, 0}, {255, 204, 0}, {255, 210, 0}, {255, 216, 0}, {255, 222, 0}, {255, 228, 0}, {255, 234, 0},
+        {255, 240, 0}, {255, 246, 0}, {255, 252, 0}, {251, 255, 0}, {245, 255, 0}, {239, 255, 0}, {233, 255, 0}, {227, 255, 0},
+        {221, 255, 0}, {215, 255, 0}, {209, 255, 0}, {203, 255, 0}, {197, 255, 0}, {191, 255, 0}, {185, 255, 0}, {179, 255, 0},
+        {173, 255, 0}, {167, 255, 0}, {161, 255, 0}, {155, 255, 0}, {149, 255, 0}, {143, 255, 0}, {137, 255, 0}, {131, 255, 0},
+        {125, 255, 0}, {119, 255, 0}, {113, 255, 0}, {107, 255, 0}, {101, 255, 0}, {95, 255, 0}, {89, 255, 0}, {83, 255, 0},
+        {77, 255, 0}, {71, 255, 0}, {65, 255, 0}, {59, 255, 0}, {53, 255, 0}, {47, 255, 0}, {41, 255, 0}, {35, 255, 0},
+        {29, 255, 0}, {23, 255, 0}, {17, 255, 0}, {11, 255, 0}, {5, 255, 0}, {0, 255, 0}, {0, 255, 6}, {0, 255, 11},
+        {0, 255, 18}, {0, 255, 23}, {0, 255, 30}, {0, 255, 35}, {0, 255, 42}, {0, 255, 47}, {0, 255, 54}, {0, 255, 59},
+        {0, 255, 66}, {0, 255, 71}, {0, 255, 78}, {0, 255, 83}, {0, 255, 90}, {0, 255, 95}, {0, 255, 102}, {0, 255, 107},
+        {0, 255, 114}, {0, 255, 119}, {0, 255, 126}, {0, 255, 131}, {0, 255, 138}, {0, 255, 143}, {0, 255, 150}, {0, 255, 155},
+        {0, 255, 162}, {0, 255, 167}, {0, 255, 174}, {0, 255, 179}, {0, 255, 186}, {0, 255, 191}, {0, 255, 198}, {0, 255, 203},
+        {0, 255, 210}, {0, 255, 215}, {0, 255, 222}, {0, 255, 227}, {0, 255, 234}, {0, 255, 239}, {0, 255, 246}, {0, 255, 251},
+        {0, 251, 255}, {0, 245, 255}, {0, 239, 255}, {0, 233, 255}, {0, 227, 255}, {0, 221, 255}, {0, 215, 255}, {0, 209, 255},
+        {0, 203, 255}, {0, 197, 255}, {0, 191, 255}, {0, 185, 255}, {0, 179, 255}, {0, 173, 255}, {0, 167, 255}, {0, 161, 255},
+        {0, 155, 255}, {0, 149, 255}, {0, 143, 255}, {0, 137, 255}, {0, 131, 255}, {0, 125, 255}, {0, 119, 255}, {0, 113, 255},
+        {0, 107, 255}, {0, 101, 255}, {0, 95, 255}, {0, 89, 255}, {0, 83, 255}, {0, 77, 255}, {0, 71, 255}, {0, 65, 255},
+        {0, 59, 255}, {0, 53, 255}, {0, 47, 255}, {0, 41, 255}, {0, 35, 255}, {0, 29, 255}, {0, 23, 255}, {0, 17, 255},
+        {0, 11, 255}, {0, 5, 255}, {0, 0, 255}, {6, 0, 255}, {12, 0, 255}, {17, 0, 255}, {23, 0, 255}, {30, 0, 255},
+        {36, 0, 255}, {42, 0, 255}, {47, 0, 255}, {54, 0, 255}, {60, 0, 255}, {65, 0, 255}, {71, 0, 255}, {78, 0, 255},
+        {84, 0, 255}, {90, 0, 255}, {95, 0, 255}, {102, 0, 255}, {108, 0, 255}, {113, 0, 255}, {119, 0, 255}, {126, 0, 255},
+        {132, 0, 255}, {138, 0, 255}, {143, 0, 255}, {150, 0, 255}, {156, 0, 255}, {161, 0, 255}, {167, 0, 255}, {174, 0, 255},
+        {180, 0, 255}, {186, 0, 255}, {191, 0, 255}, {198, 0, 255}, {204, 0, 255}, {209, 0, 255}, {215, 0, 255}, {222, 0, 255},
+        {228, 0, 255}, {234, 0, 255}, {239, 0, 255}, {246, 0, 255}, {252, 0, 255}, {255, 0, 252}, {255, 0, 246}, {255, 0, 239},
+        {255, 0, 233}, {255, 0, 227}, {255, 0, 222}, {255, 0, 215}, {255, 0, 209}, {255, 0, 204}, {255, 0, 198}, {255, 0, 191},
+        {255, 0, 185}, {255, 0, 179}, {255, 0, 174}, {255, 0, 167}, {255, 0, 161}, {255, 0, 156}, {255, 0, 150}, {255, 0, 143},
+        {255, 0, 137}, {255, 0, 131}, {255, 0, 126}, {255, 0, 119}, {255, 0, 113}, {255, 0, 108}, {255, 0, 102}, {255, 0, 95},
+        {255, 0, 89}, {255, 0, 83}, {255, 0, 78}, {255, 0, 71}, {255, 0, 65}, {255, 0, 60}, {255, 0, 54}, {255, 0, 47},
+        {255, 0, 41}, {255, 0, 35}, {255, 0, 30}, {255, 0, 23}, {255, 0, 17}, {255, 0, 12}, {255, 0, 6}, {255, 0, 0}
+};
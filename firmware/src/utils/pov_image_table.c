@@ -0,0 +1,269 @@
+#pragma once
+
+#include <stdint.h>
+
+#define POV_IMAGE_COLUMN_BITS (7)
+#define POV_IMAGE_COLUMNS (1 << POV_IMAGE_COLUMN_BITS)
+#define POV_IMAGE_ROWS (16)
+
+/* Polar image for LEDFilter_POV, a smiley with a blue rim. Column c covers the angles from c to c + 1 turns / 128,
+ * measured clockwise from the top as seen from the right hand side of the bike, row r the radii from r to r + 1
+ * sixteenths of the wheel radius. Rendered from a drawing with 4x4 samples per cell. */
+static const uint8_t pov_image[POV_IMAGE_COLUMNS][POV_IMAGE_ROWS][3] = {
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {128, 90, 0}, {0, 0, 0}, {112, 79, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {48, 34, 0}, {0, 0, 0}, {0, 0, 0},
+         {223, 158, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {143, 101, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {96, 68, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {96, 68, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {143, 101, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {48, 34, 0}, {0, 0, 0}, {0, 0, 0},
+         {223, 158, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {128, 90, 0}, {0, 0, 0}, {112, 79, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {241, 135, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {252, 169, 0}, {214, 45, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {228, 90, 0}, {200, 0, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {252, 169, 0}, {214, 45, 0},
+         {214, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {241, 135, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {128, 90, 0}, {0, 0, 0}, {112, 79, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {48, 34, 0}, {0, 0, 0}, {0, 0, 0},
+         {223, 158, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {143, 101, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {96, 68, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {64, 45, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {96, 68, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
+         {143, 101, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {48, 34, 0}, {0, 0, 0}, {0, 0, 0},
+         {223, 158, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {128, 90, 0}, {0, 0, 0}, {112, 79, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 135, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}},
+        {{255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0},
+         {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {255, 180, 0}, {191, 150, 64}, {0, 60, 255}, {0, 60, 255}}
+};
@@ -1,11 +0,0 @@
-#include <stdbool.h>
-#include "globals.h"
-
-void toggle_power(){
-    if(is_system_on){
-        is_system_on = false;
-
-    } else {
-        is_system_on = true;
-    }
-}
\ No newline at end of file
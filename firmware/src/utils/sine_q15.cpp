@@ -0,0 +1,7 @@
+/*
+ * File: sine_q15.cpp
+ * Description: The one copy of the sine table of utils/sine_q15.h.
+ */
+
+#include "sine_q15.h"
+#include "utils/sine_q15_table.c"
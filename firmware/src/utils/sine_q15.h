@@ -0,0 +1,32 @@
+/*
+ * File: sine_q15.h
+ * Description: Table sine on a 32-bit phase, for effects that step through a wave per pixel.
+ *
+ * A full period is 2^32, so phases wrap for free when they overflow and advancing a
+ * wave is a single integer add. The top 10 bits (rounded) select one of 1024 table
+ * entries, which is within 0.3% of sinf() and costs one load.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define SINE_Q15_ONE (32767)
+#define SINE_Q15_TABLE_BITS (10)
+
+/* Defined once in sine_q15.cpp, from utils/sine_q15_table.c. */
+extern const int16_t sine_q15_table[1 << SINE_Q15_TABLE_BITS];
+
+// Phase units per radian, 2^32 / 2pi.
+#define SINE_PHASE_PER_RADIAN (683565275.6f)
+
+static inline int16_t sine_q15(uint32_t phase) {
+    const uint32_t shift = 32 - SINE_Q15_TABLE_BITS;
+    return sine_q15_table[((phase + (1U << (shift - 1))) >> shift) & ((1U << SINE_Q15_TABLE_BITS) - 1)];
+}
+
+/**
+ * @brief Converts an angle in radians into phase units. Angles of 2pi and more wrap.
+ */
+static inline uint32_t sine_phase_from_radians(float radians) {
+    return (uint32_t) (int64_t) (radians * SINE_PHASE_PER_RADIAN);
+}
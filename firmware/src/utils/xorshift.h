@@ -0,0 +1,30 @@
+/*
+ * File: xorshift.h
+ * Description: Marsaglia's xorshift32 generator, three shifts and xors per number.
+ *
+ * Good enough for effects, cheaper than rand() and without shared state: every user
+ * keeps its own. The state must not be 0, xorshift32_seed() takes care of that.
+ */
+#pragma once
+
+#include <stdint.h>
+
+static inline uint32_t xorshift32(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline uint32_t xorshift32_seed(uint32_t seed) {
+    return seed != 0 ? seed : 0x9E3779B9U;
+}
+
+/**
+ * @brief Random number in [0, range) without a division, range must be at most 2^16.
+ */
+static inline uint32_t xorshift32_below(uint32_t *state, uint32_t range) {
+    return ((xorshift32(state) >> 16) * range) >> 16;
+}
@@ -0,0 +1,249 @@
+/*
+ * File: watchdog.cpp
+ * Description:
+ * The frame stages run on WDOG1 with a period of WATCHDOG_PERIOD_MS, a hang is
+ * cleared within a fraction of a second. WDOG0 belongs to the kernel's thread
+ * watchdog, which has a period of 10 seconds.
+ *
+ * The per-frame cost is a few stores: watchdog_begin() writes the running stage
+ * and its start tick to reboot-safe RAM, watchdog_checkin() sets a bit and checks
+ * how long the stage took. Only watchdog_feed() calls into the driver, once per
+ * frame. A frame with a stage past its deadline is not fed; the watchdog resets
+ * the chip if that goes on for WATCHDOG_PERIOD_MS, and a fed frame forgets it.
+ *
+ * Reboot-safe RAM is not cleared by a reset but holds garbage after a power on,
+ * so the record carries a magic and a check word over all of its fields and is
+ * only trusted when both match. A stage left in the record only means a stall
+ * when the EMU reports WDOG1 as the cause of the reset; the reset button, a
+ * brown-out or a lockup can hit a stage just as well.
+ */
+
+#include "watchdog.h"
+#include "kernel.h"
+#include "driver.h"
+#include "wdt.h"
+#include "logging.h"
+#include "globals.h"
+
+LOG_MODULE(watchdog)
+
+#define WATCHDOG_RETAINED_MAGIC (0x57444F47UL) // "WDOG"
+
+/* Reset cause, EFR32xG24 Wireless SoC Reference Manual. The bits add up until they are cleared. */
+#define WATCHDOG_EMU_CMD                (*(volatile uint32_t *) (EMU_MEMORY_MAPPED_ADDRESS + 0x070UL))
+#define WATCHDOG_EMU_CMD_RSTCAUSECLR    (1UL << 17)
+#define WATCHDOG_EMU_RSTCAUSE           (*(volatile uint32_t *) (EMU_MEMORY_MAPPED_ADDRESS + 0x104UL))
+#define WATCHDOG_EMU_RSTCAUSE_WDOG1     (1UL << 4)
+
+/* Survives a watchdog reset, see the file description. */
+struct watchdog_retained {
+    uint32_t magic;
+    int32_t stage;              // stage that is running, WATCHDOG_STAGE_NONE between stages
+    int32_t overdue_stage;      // stage that missed its deadline, WATCHDOG_STAGE_NONE if none did
+    uint32_t stage_tick;        // kernel tick at which the running or last stage began
+    uint32_t overdue_tick;      // kernel tick at which the overdue stage began
+    uint32_t resets;
+    uint32_t check;             // see watchdog_retained_check()
+};
+
+static struct watchdog_retained cw_reboot_safe g_retained;
+
+static int g_wdt_dev = -1;
+static uint32_t g_registered = 0;       // bit per registered stage
+static volatile uint32_t g_checked_in = 0;  // bit per stage that checked in since the last feed
+static uint32_t g_deadline_ticks[WATCHDOG_STAGE_MAX_VALUE];
+static volatile bool g_overdue = false;    // a stage missed its deadline since the last feed
+static struct watchdog_report g_report = {0, WATCHDOG_STAGE_NONE, 0};
+
+static const char *const g_stage_names[WATCHDOG_STAGE_MAX_VALUE] = {"sensors", "render", "output"};
+
+
+const char *watchdog_stage_name(int stage) {
+    return stage >= 0 && stage < WATCHDOG_STAGE_MAX_VALUE ? g_stage_names[stage] : "none";
+}
+
+
+/* Each field is rotated by a different amount so that two flipped fields do not cancel. */
+static inline uint32_t watchdog_retained_check() {
+    uint32_t stage = (uint32_t) g_retained.stage;
+    uint32_t overdue = (uint32_t) g_retained.overdue_stage;
+    uint32_t overdue_tick = g_retained.overdue_tick;
+    return ~(g_retained.magic ^ g_retained.resets ^ g_retained.stage_tick ^ ((overdue_tick << 24) | (overdue_tick >> 8)) ^
+             ((stage << 8) | (stage >> 24)) ^ ((overdue << 16) | (overdue >> 16)));
+}
+
+
+static inline void watchdog_seal_retained() {
+    g_retained.check = watchdog_retained_check();
+}
+
+
+/********************************************//**
+ *  Takes over the record of the last run. A run
+ *  that the watchdog reset and that ended inside
+ *  a stage or with a stage past its deadline was
+ *  stopped by that stage.
+ ***********************************************/
+static void watchdog_read_retained() {
+    uint32_t cause = WATCHDOG_EMU_RSTCAUSE;
+    WATCHDOG_EMU_CMD = WATCHDOG_EMU_CMD_RSTCAUSECLR;
+
+    bool valid = g_retained.magic == WATCHDOG_RETAINED_MAGIC &&
+                 g_retained.check == watchdog_retained_check();
+
+    if (!valid) {
+        g_retained.magic = WATCHDOG_RETAINED_MAGIC;
+        g_retained.resets = 0;
+    } else if (cause & WATCHDOG_EMU_RSTCAUSE_WDOG1) {
+        /* A stage past its deadline kept the watchdog from being fed, otherwise the chip hung in the running one. */
+        bool overdue = g_retained.overdue_stage != WATCHDOG_STAGE_NONE;
+        int stalled = overdue ? g_retained.overdue_stage : g_retained.stage;
+        uint32_t stalled_tick = overdue ? g_retained.overdue_tick : g_retained.stage_tick;
+        g_retained.resets++;
+        if (stalled >= 0 && stalled < WATCHDOG_STAGE_MAX_VALUE) {
+            g_report.stalled_stage = stalled;
+            g_report.stalled_tick = stalled_tick;
+            LOG_WARNING("Watchdog reset, the %s stage stalled at tick %lu (%lu resets since power on).",
+                        watchdog_stage_name(stalled), (unsigned long) stalled_tick,
+                        (unsigned long) g_retained.resets);
+        } else {
+            LOG_WARNING("Watchdog reset outside the frame stages (%lu resets since power on).",
+                        (unsigned long) g_retained.resets);
+        }
+    }
+
+    g_report.resets = g_retained.resets;
+    g_retained.stage = WATCHDOG_STAGE_NONE;
+    g_retained.overdue_stage = WATCHDOG_STAGE_NONE;
+    g_retained.stage_tick = 0;
+    g_retained.overdue_tick = 0;
+    watchdog_seal_retained();
+}
+
+
+int watchdog_init() {
+    watchdog_read_retained();
+
+    g_wdt_dev = open("wdt1");
+    if (g_wdt_dev == -1) {
+        LOG_ERROR("Failed to open the watchdog.");
+        return -1;
+    }
+    if (wdt_enable(g_wdt_dev) != 0) {
+        LOG_ERROR("Failed to enable the watchdog.");
+        return -1;
+    }
+    return 0;
+}
+
+
+int watchdog_register(WatchdogStage stage, uint32_t deadline_ms) {
+    if (stage < 0 || stage >= WATCHDOG_STAGE_MAX_VALUE) {
+        LOG_ERROR("Invalid watchdog stage %d.", stage);
+        return -1;
+    }
+
+    g_deadline_ticks[stage] = (deadline_ms * osKernelGetTickFreq()) / 1000U;
+    g_registered |= 1U << stage;
+    return 0;
+}
+
+
+void watchdog_begin(WatchdogStage stage) {
+    g_retained.stage = stage;
+    g_retained.stage_tick = osKernelGetTickCount();
+    watchdog_seal_retained();
+}
+
+
+/********************************************//**
+ *  Records the first stage that went past its
+ *  deadline since the last feed.
+ ***********************************************/
+static void watchdog_mark_overdue(int stage) {
+    g_overdue = true;
+    if (g_retained.overdue_stage == WATCHDOG_STAGE_NONE) {
+        g_retained.overdue_stage = stage;
+        g_retained.overdue_tick = g_retained.stage_tick;
+        watchdog_seal_retained();
+        LOG_ERROR("The %s stage missed its deadline.", watchdog_stage_name(stage));
+    }
+}
+
+
+void watchdog_checkin(WatchdogStage stage) {
+    g_checked_in |= 1U << stage;
+    g_retained.stage = WATCHDOG_STAGE_NONE;
+    watchdog_seal_retained();
+
+    if ((g_registered & (1U << stage)) && osKernelGetTickCount() - g_retained.stage_tick > g_deadline_ticks[stage]) {
+        watchdog_mark_overdue(stage);
+    }
+}
+
+
+/**
+ * @brief Feeds the watchdog if every registered stage checked in and none went past its deadline.
+ *
+ * A stage that took longer than its deadline since its watchdog_begin() is recorded
+ * right away, the watchdog then resets the chip once its period runs out without a
+ * feed. A fed frame clears the record, so a later reset does not blame a stage that
+ * was late once and recovered.
+ */
+void watchdog_feed() {
+    if (g_wdt_dev == -1) {
+        return;
+    }
+
+    int running = g_retained.stage;
+    if (running >= 0 && running < WATCHDOG_STAGE_MAX_VALUE && (g_registered & (1U << running)) &&
+        osKernelGetTickCount() - g_retained.stage_tick > g_deadline_ticks[running]) {
+        watchdog_mark_overdue(running);
+    }
+
+    if (g_overdue) {
+        g_overdue = false;
+        g_checked_in = 0;
+        return;
+    }
+
+    if ((g_checked_in & g_registered) == g_registered) {
+        g_checked_in = 0;
+        if (wdt_reset(g_wdt_dev) == 0 && g_retained.overdue_stage != WATCHDOG_STAGE_NONE) {
+            g_retained.overdue_stage = WATCHDOG_STAGE_NONE;
+            watchdog_seal_retained();
+        }
+    }
+}
+
+
+/**
+ * @brief Stops the watchdog, the stages do not run while the system is off.
+ */
+void watchdog_suspend() {
+    if (g_wdt_dev != -1) {
+        wdt_disable(g_wdt_dev);
+    }
+}
+
+
+/**
+ * @brief Starts the watchdog again with a fresh period and fresh deadlines.
+ */
+void watchdog_resume() {
+    if (g_wdt_dev == -1) {
+        return;
+    }
+
+    g_overdue = false;
+    g_checked_in = 0;
+    g_retained.overdue_stage = WATCHDOG_STAGE_NONE;
+    watchdog_seal_retained();
+    wdt_reset(g_wdt_dev);
+    wdt_enable(g_wdt_dev);
+}
+
+
+void watchdog_get_report(struct watchdog_report *report) {
+    *report = g_report;
+}
@@ -0,0 +1,40 @@
+/*
+ * File: watchdog.h
+ * Description: Supervises the stages of a frame with the hardware watchdog.
+ *
+ * Each stage registers a deadline, marks where it starts with watchdog_begin()
+ * and checks in with watchdog_checkin() when it is done. watchdog_feed() runs
+ * once per frame and only feeds the watchdog when every registered stage checked
+ * in since the last feed and none is past its deadline. A stage that hangs, e.g.
+ * in an I2C or SPI transfer, lets the watchdog reset the chip, and the stage is
+ * kept in reboot-safe RAM so the next boot can report it.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// Enum to define the supervised stages of a frame.
+typedef enum {
+    WATCHDOG_STAGE_SENSORS,     // reading the ICM over I2C
+    WATCHDOG_STAGE_RENDER,      // processing, filter and encoding
+    WATCHDOG_STAGE_OUTPUT,      // SPI transfers of the strips
+    WATCHDOG_STAGE_MAX_VALUE
+} WatchdogStage;
+
+#define WATCHDOG_STAGE_NONE (-1)
+
+struct watchdog_report {
+    uint32_t resets;        // watchdog resets since power on
+    int stalled_stage;      // stage the last reset hit, WATCHDOG_STAGE_NONE after a power on or another reset
+    uint32_t stalled_tick;  // kernel tick at which that stage began
+};
+
+int  watchdog_init();                                           // Reads the report of the last reset and starts the watchdog
+int  watchdog_register(WatchdogStage stage, uint32_t deadline_ms);   // Adds a stage that has to check in within deadline_ms
+void watchdog_begin(WatchdogStage stage);                       // The stage starts, it is the one recorded if the chip resets now
+void watchdog_checkin(WatchdogStage stage);                     // The stage finished
+void watchdog_feed();                                           // Call once per frame, feeds when all stages checked in
+void watchdog_suspend();                                        // Stops the watchdog, e.g. while the system is off
+void watchdog_resume();
+void watchdog_get_report(struct watchdog_report *report);
+const char *watchdog_stage_name(int stage);
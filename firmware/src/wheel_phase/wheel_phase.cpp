@@ -0,0 +1,96 @@
+/*
+ * File: wheel_phase.cpp
+ * Description:
+ * Between two samples the wheel is assumed to speed up evenly, so the angle
+ * advances by the mean of the two rates. In the frame of the sensor gravity turns
+ * against the wheel, its angle measured from the U to the V axis is the mounting
+ * offset minus the wheel angle. The error against that measurement is corrected by
+ * WHEEL_GRAVITY_GAIN per sample, slow enough that the noise of single samples and
+ * the acceleration of braking or pedalling barely show. A gyro bias would leave a
+ * steady error behind, so the error is also integrated into a bias estimate that is
+ * subtracted from the rate.
+ *
+ * A single running mean lets part of the turning gravity through when there are
+ * only a few samples per turn, which shows as an angle error of several degrees.
+ * Two means in a row let through the square of that.
+ */
+
+#include <math.h>
+#include "wheel_phase.h"
+#include "kernel.h"
+#include "logging.h"
+#include "globals.h"
+#include "utils/sine_q15.h"
+
+LOG_MODULE(wheel_phase)
+
+static uint32_t g_phase;        // wheel angle at the last sample
+static float g_rate;            // phase units per system timer count at the last sample
+static uint32_t g_sample_sys;   // system timer count of the last sample
+static bool g_has_sample = false;
+static float g_phase_per_dps;   // phase units per system timer count at 1 degree per second
+static uint32_t g_max_gap_sys;  // longer gaps between samples restart the integration
+static float g_bias_dps;        // gyro bias learned from the gravity error
+static float g_mean_u[2];       // running mean of the acceleration in the wheel plane, two stages
+static float g_mean_v[2];
+
+
+int wheel_phase_init() {
+    uint32_t freq = osKernelGetSysTimerFreq();
+    if (freq == 0) {
+        LOG_ERROR("No system timer to time the wheel phase with.");
+        return -1;
+    }
+
+    g_phase_per_dps = (SINE_PHASE_PER_RADIAN * (float) M_PI / 180.0f) / (float) freq;
+    g_max_gap_sys = freq / 4;
+    g_has_sample = false;
+    g_bias_dps = 0;
+    return 0;
+}
+
+
+void wheel_phase_update(const float gyro[3], const float accel[3], uint32_t sample_sys) {
+    float rate_dps = gyro[WHEEL_GYRO_AXIS] * WHEEL_GYRO_SIGN - g_bias_dps;
+    float rate = rate_dps * g_phase_per_dps;
+    uint32_t gap = sample_sys - g_sample_sys;
+
+    float u = accel[WHEEL_ACCEL_AXIS_U];
+    float v = accel[WHEEL_ACCEL_AXIS_V];
+
+    if (!g_has_sample || gap > g_max_gap_sys) {
+        // After a pause, e.g. while powered off, the angle is unknown, gravity pulls it in again
+        g_mean_u[0] = g_mean_u[1] = u;
+        g_mean_v[0] = g_mean_v[1] = v;
+        g_has_sample = true;
+    } else {
+        g_phase += (uint32_t) (int64_t) ((g_rate + rate) * 0.5f * (float) gap);
+    }
+    g_rate = rate;
+    g_sample_sys = sample_sys;
+
+    g_mean_u[0] += (u - g_mean_u[0]) * WHEEL_ACCEL_MEAN_GAIN;
+    g_mean_v[0] += (v - g_mean_v[0]) * WHEEL_ACCEL_MEAN_GAIN;
+    g_mean_u[1] += (g_mean_u[0] - g_mean_u[1]) * WHEEL_ACCEL_MEAN_GAIN;
+    g_mean_v[1] += (g_mean_v[0] - g_mean_v[1]) * WHEEL_ACCEL_MEAN_GAIN;
+
+    // At low rates the mean would take up gravity as well
+    if (fabsf(rate_dps) >= WHEEL_GRAVITY_MIN_DPS) {
+        float gravity = atan2f(v - g_mean_v[1], u - g_mean_u[1]);
+        uint32_t measured = sine_phase_from_radians((WHEEL_UP_OFFSET_DEG * (float) M_PI / 180.0f) - gravity);
+        int32_t error = (int32_t) (measured - g_phase);
+        g_phase += (uint32_t) (int32_t) ((float) error * WHEEL_GRAVITY_GAIN);
+        g_bias_dps -= (float) error * (360.0f / 4294967296.0f) * WHEEL_GYRO_BIAS_GAIN;
+    }
+}
+
+
+uint32_t wheel_phase_at(uint32_t sys) {
+    int32_t elapsed = (int32_t) (sys - g_sample_sys);
+    return g_phase + (uint32_t) (int64_t) (g_rate * (float) elapsed);
+}
+
+
+float wheel_phase_rate_dps() {
+    return g_rate / g_phase_per_dps;
+}
@@ -0,0 +1,40 @@
+/*
+ * File: wheel_phase.h
+ * Description: Estimates the angle of the wheel, for effects that are drawn in the
+ * frame of the road instead of the frame of the wheel.
+ *
+ * The gyro axis along the axle gives the rate the wheel turns at. The angle is
+ * integrated from it at every sensor sample and extrapolated with the rate in
+ * between, so it can be read for any point in time, e.g. the moment the next frame
+ * latches. Integrated gyro drifts, so while the wheel turns fast enough the angle is
+ * pulled towards the direction of gravity, which turns around the sensor once per
+ * revolution. The constant centripetal part of the acceleration is removed with a
+ * running mean first.
+ *
+ * The angle is a 32-bit phase, 2^32 is a turn, as in utils/sine_q15.h. It is 0 when
+ * the valve hole is at the top (see WHEEL_UP_OFFSET_DEG) and grows in the direction
+ * the wheel turns when riding forward.
+ */
+#pragma once
+#include <stdint.h>
+
+int wheel_phase_init();
+
+/**
+ * @brief Feeds one sensor sample.
+ *
+ * @param gyro Rates in degrees per second, as read from the ICM.
+ * @param accel Acceleration in g, as read from the ICM.
+ * @param sample_sys System timer count at which the sample was taken.
+ */
+void wheel_phase_update(const float gyro[3], const float accel[3], uint32_t sample_sys);
+
+/**
+ * @brief Wheel angle at a system timer count, extrapolated from the last sample.
+ */
+uint32_t wheel_phase_at(uint32_t sys);
+
+/**
+ * @brief Rate the wheel turns at in degrees per second, positive when riding forward.
+ */
+float wheel_phase_rate_dps();
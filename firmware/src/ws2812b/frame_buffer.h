@@ -0,0 +1,108 @@
+/*
+ * File: frame_buffer.h
+ * Description: The frame that filters render into and the strip driver encodes from.
+ *
+ * A frame is one packed array of num_pixels pixels, numbered across the strips in
+ * the order of led_strip_layout. Filters write it in place and the driver walks it
+ * once per frame, so pixels are not copied between the two.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "utils/blend_simd.h"
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+// Enum to define the byte layout of a pixel.
+typedef enum {
+    PIXEL_FORMAT_RGB888,     // red, green, blue
+    PIXEL_FORMAT_GRB888,     // green, red, blue, the wire order of WS2812B and SK6812
+    PIXEL_FORMAT_RGBW8888,   // red, green, blue and a white channel that adds to all three
+} PixelFormat;
+
+#define PIXEL_FORMAT_BYTES(format) ((format) == PIXEL_FORMAT_RGBW8888 ? 4 : 3)
+
+typedef struct {
+    PixelFormat format;
+    int bytes_per_pixel;
+    int num_pixels;
+    uint8_t *pixels;
+} FrameBuffer;
+
+
+static inline uint8_t *frame_buffer_pixel(FrameBuffer *frame, int index) {
+    return frame->pixels + frame->bytes_per_pixel * index;
+}
+
+/**
+ * @brief Writes one pixel. The index is not bounds checked.
+ */
+static inline void frame_buffer_set_rgb(FrameBuffer *frame, int index, uint8_t red, uint8_t green, uint8_t blue) {
+    uint8_t *pixel = frame_buffer_pixel(frame, index);
+
+    switch (frame->format) {
+        case PIXEL_FORMAT_GRB888:
+            pixel[0] = green;
+            pixel[1] = red;
+            pixel[2] = blue;
+            break;
+        case PIXEL_FORMAT_RGBW8888:
+            pixel[3] = 0;
+            /* fall through */
+        default:
+            pixel[0] = red;
+            pixel[1] = green;
+            pixel[2] = blue;
+            break;
+    }
+}
+
+/**
+ * @brief Reads one pixel as RGB. White is added to all three channels, saturating.
+ */
+static inline void frame_buffer_get_rgb(const FrameBuffer *frame, int index, uint8_t *red, uint8_t *green, uint8_t *blue) {
+    const uint8_t *pixel = frame->pixels + frame->bytes_per_pixel * index;
+
+    switch (frame->format) {
+        case PIXEL_FORMAT_GRB888:
+            *red = pixel[1];
+            *green = pixel[0];
+            *blue = pixel[2];
+            break;
+        case PIXEL_FORMAT_RGBW8888: {
+            uint8_t white = pixel[3];
+            *red = (uint8_t) (pixel[0] + white > 255 ? 255 : pixel[0] + white);
+            *green = (uint8_t) (pixel[1] + white > 255 ? 255 : pixel[1] + white);
+            *blue = (uint8_t) (pixel[2] + white > 255 ? 255 : pixel[2] + white);
+            break;
+        }
+        default:
+            *red = pixel[0];
+            *green = pixel[1];
+            *blue = pixel[2];
+            break;
+    }
+}
+
+static inline void frame_buffer_fill(FrameBuffer *frame, uint8_t red, uint8_t green, uint8_t blue) {
+    for (int i = 0; i < frame->num_pixels; i++) {
+        frame_buffer_set_rgb(frame, i, red, green, blue);
+    }
+}
+
+/**
+ * @brief Blends from into dst, dst = from + (dst - from) * weight / 256.
+ *
+ * Both frames must have the same format and size.
+ *
+ * @param weight Share of dst, 0 keeps from and 256 keeps dst.
+ */
+static inline void frame_buffer_blend(FrameBuffer *dst, const FrameBuffer *from, uint32_t weight) {
+    blend_bytes(dst->pixels, from->pixels, dst->num_pixels * dst->bytes_per_pixel, BLEND_MODE_ALPHA, 256U - weight);
+}
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,133 @@
+/*
+ * File: led_protocol.cpp
+ * Description: WS2812B, SK6812 RGBW and APA102 backends of the strip driver.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "led_protocol.h"
+#include "ws2812b_encoding.h"
+#include "globals.h"
+
+#define APA102_START_FRAME_BYTES (4)
+#define APA102_LED_FRAME_HEADER  (0xE0 | 31) // three marker bits and the full 5 bit global brightness
+
+
+static_assert(one_wire_timing_valid<Sk6812Encoder>(SK6812_TIMING, SK6812_SPI_BAUDRATE), "SK6812_SPI_BAUDRATE is outside the SK6812 timing tolerance");
+
+
+static int no_trailer(int num_pixels) {
+    return 0;
+}
+
+static void init_one_wire_frame(uint8_t *buf, int num_pixels) {
+    /* One-wire chips latch on the low line after the frame, there is no header or trailer. */
+}
+
+
+/********************************************//**
+ *  WS2812B: green, red, blue, each expanded with
+ *  the encoding selected by WS2812B_ENCODING.
+ ***********************************************/
+static void ws2812b_encode_pixel(uint8_t *out, uint8_t red, uint8_t green, uint8_t blue) {
+    const uint8_t wire[3] = {green, red, blue};
+    Ws2812bEncoder::encode_channels(out, wire, 3);
+}
+
+/* With the 3 bit word encoding a group is 36 bytes, written as nine word stores. */
+static void ws2812b_encode_group(uint8_t *out, const uint8_t (*pixels)[3]) {
+    uint8_t wire[3 * LED_PROTOCOL_GROUP_PIXELS];
+    for (int i = 0; i < LED_PROTOCOL_GROUP_PIXELS; i++) {
+        wire[3 * i + 0] = pixels[i][1];
+        wire[3 * i + 1] = pixels[i][0];
+        wire[3 * i + 2] = pixels[i][2];
+    }
+    Ws2812bEncoder::encode_channels(out, wire, 3 * LED_PROTOCOL_GROUP_PIXELS);
+}
+
+const struct led_protocol led_protocol_ws2812b = {
+        "ws2812b",
+        3 * Ws2812bEncoder::BYTES_PER_CHANNEL,
+        0,
+        no_trailer,
+        init_one_wire_frame,
+        ws2812b_encode_pixel,
+        ws2812b_encode_group,
+        12,
+        1000,
+};
+
+
+/********************************************//**
+ *  SK6812 RGBW: the part of the colour that all
+ *  three channels share goes to the white LED,
+ *  which gives more light per milliamp.
+ ***********************************************/
+static void sk6812_rgbw_encode_pixel(uint8_t *out, uint8_t red, uint8_t green, uint8_t blue) {
+    uint8_t white = std::min(red, std::min(green, blue));
+    const uint8_t wire[4] = {(uint8_t) (green - white), (uint8_t) (red - white), (uint8_t) (blue - white), white};
+    Sk6812Encoder::encode_channels(out, wire, 4);
+}
+
+static void sk6812_rgbw_encode_group(uint8_t *out, const uint8_t (*pixels)[3]) {
+    for (int i = 0; i < LED_PROTOCOL_GROUP_PIXELS; i++) {
+        sk6812_rgbw_encode_pixel(out, pixels[i][0], pixels[i][1], pixels[i][2]);
+        out += 4 * Sk6812Encoder::BYTES_PER_CHANNEL;
+    }
+}
+
+const struct led_protocol led_protocol_sk6812_rgbw = {
+        "sk6812_rgbw",
+        4 * Sk6812Encoder::BYTES_PER_CHANNEL,
+        0,
+        no_trailer,
+        init_one_wire_frame,
+        sk6812_rgbw_encode_pixel,
+        sk6812_rgbw_encode_group,
+        12,  // estimated as RGB, which overstates pixels that use the white LED
+        1000,
+};
+
+
+/********************************************//**
+ *  APA102: clocked, so the colour bytes go out as
+ *  they are. The end frame gives the half clock per
+ *  pixel that pushes the data down the chain, plus
+ *  the 32 zero bits an SK9822 needs to latch.
+ ***********************************************/
+static int apa102_trailer_bytes(int num_pixels) {
+    return 4 + (num_pixels + 15) / 16;
+}
+
+static void apa102_init_frame(uint8_t *buf, int num_pixels) {
+    memset(buf, 0x00, APA102_START_FRAME_BYTES);
+    memset(buf + APA102_START_FRAME_BYTES + 4 * num_pixels, 0x00, apa102_trailer_bytes(num_pixels));
+}
+
+static void apa102_encode_pixel(uint8_t *out, uint8_t red, uint8_t green, uint8_t blue) {
+    out[0] = APA102_LED_FRAME_HEADER;
+    out[1] = blue;
+    out[2] = green;
+    out[3] = red;
+}
+
+/* An LED frame is exactly one word, header in the lowest byte. */
+static void apa102_encode_group(uint8_t *out, const uint8_t (*pixels)[3]) {
+    for (int i = 0; i < LED_PROTOCOL_GROUP_PIXELS; i++) {
+        uint32_t frame = APA102_LED_FRAME_HEADER | ((uint32_t) pixels[i][2] << 8) |
+                         ((uint32_t) pixels[i][1] << 16) | ((uint32_t) pixels[i][0] << 24);
+        memcpy(out + 4 * i, &frame, sizeof(frame));
+    }
+}
+
+const struct led_protocol led_protocol_apa102 = {
+        "apa102",
+        4,
+        APA102_START_FRAME_BYTES,
+        apa102_trailer_bytes,
+        apa102_init_frame,
+        apa102_encode_pixel,
+        apa102_encode_group,
+        20,
+        700,
+};
@@ -0,0 +1,45 @@
+/*
+ * File: led_protocol.h
+ * Description: The wire protocols of the LED chipsets the strip driver can drive.
+ *
+ * A backend turns gamma corrected RGB values into the SPI bytes of its chipset, so
+ * the driver and the filters stay the same whatever LEDs are wound into the wheel.
+ * The SPI buffer of a strip holds header_bytes, then bytes_per_pixel per pixel,
+ * then trailer_bytes(num_pixels).
+ *
+ * The driver encodes pixels in groups of LED_PROTOCOL_GROUP_PIXELS with
+ * encode_group(), which lets a backend write whole words. Only a strip's last,
+ * partial group goes through encode_pixel().
+ *
+ * channel_ma and idle_ua feed the driver's current estimate. They are datasheet
+ * typicals, the limiter only has to be right to within the regulator's margin.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+#define LED_PROTOCOL_GROUP_PIXELS (4)
+
+struct led_protocol {
+    const char *name;
+    int bytes_per_pixel;
+    int header_bytes;
+    int (*trailer_bytes) (int num_pixels);
+    void (*init_frame) (uint8_t *buf, int num_pixels);     ///< writes the header and trailer of a strip buffer
+    void (*encode_pixel) (uint8_t *out, uint8_t red, uint8_t green, uint8_t blue);
+    void (*encode_group) (uint8_t *out, const uint8_t (*pixels)[3]); ///< encodes LED_PROTOCOL_GROUP_PIXELS pixels
+    uint16_t channel_ma;                                   ///< current of one channel at full value
+    uint16_t idle_ua;                                      ///< quiescent current of one pixel, also when it is black
+};
+
+extern const struct led_protocol led_protocol_ws2812b;     ///< WS2812B, GRB one-wire, WS2812B_ENCODING at SPI_BAUDRATE
+extern const struct led_protocol led_protocol_sk6812_rgbw; ///< SK6812 RGBW, GRBW one-wire at SK6812_SPI_BAUDRATE
+extern const struct led_protocol led_protocol_apa102;      ///< APA102/SK9822, clocked, 4 bytes per pixel at 8 MHz and up
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,86 @@
+/*
+ * File: one_wire_decoder.cpp
+ * Description: Decodes and checks the SPI stream of one-wire strips, see one_wire_decoder.h.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "one_wire_decoder.h"
+
+
+static inline int stream_bit(const uint8_t *stream, int bit) {
+    return (stream[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+static inline bool in_window(uint32_t ns, uint16_t min_ns, uint16_t max_ns) {
+    return ns >= min_ns && ns <= max_ns;
+}
+
+
+int one_wire_decode(const uint8_t *stream, int stream_bytes, uint32_t baudrate, const OneWireTiming &timing,
+                    uint8_t *out, int out_bytes, OneWireDecodeReport *report) {
+    OneWireDecodeReport local;
+    if (report == NULL) {
+        report = &local;
+    }
+    memset(report, 0, sizeof(*report));
+    report->first_violation_bit = -1;
+    report->high_ns_min[0] = report->high_ns_min[1] = UINT32_MAX;
+
+    /* A high pulse longer than halfway between the two windows is a 1. */
+    uint32_t threshold_ns = (timing.t0h_max + timing.t1h_min) / 2;
+    int total_bits = 8 * stream_bytes;
+    int pos = 0;
+    int decoded = 0;
+
+    while (pos < total_bits && stream_bit(stream, pos) == 0) {
+        pos++;
+    }
+
+    while (pos < total_bits) {
+        int high_bits = 0;
+        int low_bits = 0;
+        while (pos < total_bits && stream_bit(stream, pos) == 1) {
+            high_bits++;
+            pos++;
+        }
+        while (pos < total_bits && stream_bit(stream, pos) == 0) {
+            low_bits++;
+            pos++;
+        }
+
+        uint32_t high_ns = (uint32_t) (((uint64_t) high_bits * 1000000000U) / baudrate);
+        uint32_t low_ns = (uint32_t) (((uint64_t) low_bits * 1000000000U) / baudrate);
+        int value = high_ns > threshold_ns ? 1 : 0;
+        bool last = pos >= total_bits;
+
+        bool valid;
+        if (value == 1) {
+            valid = in_window(high_ns, timing.t1h_min, timing.t1h_max) &&
+                    (last || in_window(low_ns, timing.t1l_min, timing.t1l_max));
+        } else {
+            valid = in_window(high_ns, timing.t0h_min, timing.t0h_max) &&
+                    (last || in_window(low_ns, timing.t0l_min, timing.t0l_max));
+        }
+        if (!valid) {
+            if (report->timing_violations == 0) {
+                report->first_violation_bit = report->bits;
+            }
+            report->timing_violations++;
+        }
+        report->high_ns_min[value] = std::min(report->high_ns_min[value], high_ns);
+        report->high_ns_max[value] = std::max(report->high_ns_max[value], high_ns);
+
+        int byte = report->bits >> 3;
+        if (byte < out_bytes) {
+            if ((report->bits & 7) == 0) {
+                out[byte] = 0;
+            }
+            out[byte] |= (uint8_t) (value << (7 - (report->bits & 7)));
+            decoded = byte + 1;
+        }
+        report->bits++;
+    }
+
+    return (report->bits & 7) == 0 ? std::min(decoded, report->bits >> 3) : -1;
+}
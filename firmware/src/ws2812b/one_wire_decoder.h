@@ -0,0 +1,45 @@
+/*
+ * File: one_wire_decoder.h
+ * Description: Decodes the SPI stream of a one-wire strip back into colour bytes.
+ *
+ * The decoder plays the part of the first LED on the strip: it turns the SPI bits
+ * into the high and low pulses the line carries at the given baudrate, checks every
+ * pulse against the datasheet windows of ws2812b_encoding.h and reads the data bits
+ * out of them. It only depends on the encoding header and is built for the host by
+ * test/CMakeLists.txt, which checks the encoders against the timing instead of
+ * against another encoder and decodes captured SPI dumps with one_wire_decode.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "ws2812b_encoding.h"
+
+/**
+ * @brief What the decoder measured on a stream.
+ */
+struct OneWireDecodeReport {
+    int bits;                   ///< data bits decoded
+    int timing_violations;      ///< pulses outside the datasheet windows
+    int first_violation_bit;    ///< data bit of the first violation, -1 if there was none
+    uint32_t high_ns_min[2];    ///< shortest high pulse of a 0 and of a 1
+    uint32_t high_ns_max[2];    ///< longest high pulse of a 0 and of a 1
+};
+
+/**
+ * @brief Decodes an SPI stream into the data bytes the LEDs receive.
+ *
+ * Leading low bits are idle line and skipped. The low pulse of the last bit runs
+ * into the latch gap and is not checked.
+ *
+ * @param stream SPI bytes as clocked out, MSB first.
+ * @param stream_bytes Length of stream.
+ * @param baudrate SPI baudrate the stream is sent at.
+ * @param timing Datasheet windows of the chip.
+ * @param out Decoded bytes in wire order.
+ * @param out_bytes Size of out.
+ * @param report Filled with the measured pulses, may be NULL.
+ * @return Number of bytes decoded, or -1 if the stream ends in the middle of a byte.
+ */
+int one_wire_decode(const uint8_t *stream, int stream_bytes, uint32_t baudrate, const OneWireTiming &timing,
+                    uint8_t *out, int out_bytes, OneWireDecodeReport *report);
+
@@ -0,0 +1,796 @@
+/*******************************************************************************
+ * @file      $file.fileName
+ * @license   This file is part of the ImagineOn Coldwave eOS software package 
+ *            licensed under the ImagineOn software-licensing terms available 
+ *            under https://www.imagineon.de/de/info/licensing-terms
+ * @copyright Copyright (c) $originalComment.match("Copyright (c) (\d+)", 1, "-", "$today.year")$today.year. ImagineOn GmbH. www.imagineon.de.
+*******************************************************************************/
+
+
+#include <string.h>
+#include <algorithm>
+#include "driver.h"
+#include "spi.h"
+/* timer.h reuses the include guard of spi.h */
+#undef _COLDWAVEOS_SPI_H
+#include "timer.h"
+#include "kernel.h"
+#include "utils/gamma16_table.c"
+#include "ws2812b.h"
+#include "logging.h"
+#include "gpio.h"
+#include "globals.h"
+
+
+#define IS_NORMALIZED(x)      ((x >= 0.0F) && (x <= 1.0F))
+
+/********************************************//**
+ *  reset code >= 50us
+ *  50us / .4 us = 125
+ *  Only sent when the latch timer is not available.
+ ***********************************************/
+#define RESET_CODE_LENGTH     (150) //
+
+/* The one-shot fires WS2812B_RESET_US after the last transfer, plus one byte time
+ * for the bits that are still in the shift register when spi_write() returns. */
+#define LATCH_TIMER_FREQUENCY_HZ (1000000 / (WS2812B_RESET_US + 8000000 / SPI_BAUDRATE))
+
+#define LED_STRIP_MAX_STRIPS        (4)
+#define LED_STRIP_FLAG_TRANSFER     (0x01U)
+#define LED_STRIP_THREAD_STACK_SIZE (512)
+LOG_MODULE(ws2812b.c)
+
+
+/**
+ * @brief One physical strip on its own SPI device.
+ *
+ * Each strip owns its SPI buffer. For dirty tracking, its pixels in the frame that was
+ * last submitted are compared with the new frame, so unchanged pixels are not
+ * re-encoded and unchanged strips are not re-sent.
+ */
+struct led_strip {
+    int index;
+    const struct led_protocol *protocol;
+    int spi_dev;
+    int first_pixel;                 ///< offset of the strip's first pixel in the frame
+    int num_pixels;
+    uint8_t *data_buf;
+    uint8_t *pixel_buf;              ///< first pixel in data_buf, after the protocol's header
+    int buffer_size_bytes;
+    uint16_t (*linear)[3];           ///< gamma corrected, white balanced pixels in 8.8 fixed point
+    uint8_t (*dither_error)[3];      ///< fraction each channel still owes to the next output frames
+    uint32_t linear_sum;             ///< sum of all channels in linear, for the current estimate
+    uint8_t *black_group;            ///< encoding of LED_PROTOCOL_GROUP_PIXELS black pixels
+    bool cache_valid;
+    bool dirty;
+    int frames_since_transfer;
+    osThreadId_t output_thread;      ///< sends the strip in parallel to strip 0, NULL for strip 0
+};
+
+static struct led_strip g_led_strips[LED_STRIP_MAX_STRIPS];
+static int g_led_strip_count = 0;
+static struct led_strip *g_selected_strip = &g_led_strips[0];
+static osEventFlagsId_t g_led_strip_done_flags;
+static float g_led_strip_color_bal[3] = {1.0F, 1.0F, 1.0F};
+static uint32_t g_led_strip_channel_scale[3] = {65536, 65536, 65536}; // white balance times brightness in Q16
+static uint32_t g_led_strip_brightness = 65536; // set by the current limiter in Q16
+static const uint8_t nulls[RESET_CODE_LENGTH] = {0};
+static int g_latch_timer_dev = -1;
+static osSemaphoreId_t g_latch_done;
+static struct led_strip_stats g_led_strip_stats;
+static uint32_t g_led_strip_latch_sys;   // system timer count at which the last transfer latches
+
+/* Filters render into the back frame while the front frame holds what the strips show.
+ * Submitting a frame swaps the two, so the previous frame is kept without a copy. */
+static uint8_t g_frame_pixels[2][NUM_PIXELS * PIXEL_FORMAT_BYTES(LED_STRIP_PIXEL_FORMAT)];
+static FrameBuffer g_frames[2] = {
+        {LED_STRIP_PIXEL_FORMAT, PIXEL_FORMAT_BYTES(LED_STRIP_PIXEL_FORMAT), NUM_PIXELS, g_frame_pixels[0]},
+        {LED_STRIP_PIXEL_FORMAT, PIXEL_FORMAT_BYTES(LED_STRIP_PIXEL_FORMAT), NUM_PIXELS, g_frame_pixels[1]},
+};
+static FrameBuffer *g_front_frame = &g_frames[0];
+static FrameBuffer *g_back_frame = &g_frames[1];
+
+
+/********************************************//**
+ *  Output thread of a secondary strip. It waits for
+ *  update_leds() to request a transfer, so the strips
+ *  are clocked out at the same time.
+ ***********************************************/
+static void led_strip_output_thread(void *argument) {
+    struct led_strip *strip = (struct led_strip *) argument;
+
+    while (1) {
+        osThreadFlagsWait(LED_STRIP_FLAG_TRANSFER, osFlagsWaitAny, osWaitForever);
+        spi_write(strip->spi_dev, strip->data_buf, strip->buffer_size_bytes);
+        if (g_latch_timer_dev == -1) {
+            spi_write(strip->spi_dev, nulls, RESET_CODE_LENGTH);
+        }
+        osEventFlagsSet(g_led_strip_done_flags, 1U << strip->index);
+    }
+}
+
+
+static int led_strip_init_strip(struct led_strip *strip, const struct led_strip_config *config, int first_pixel) {
+    strip->protocol = config->protocol;
+    strip->first_pixel = first_pixel;
+    strip->num_pixels = config->num_pixels;
+    strip->buffer_size_bytes = strip->protocol->header_bytes +
+                               strip->protocol->bytes_per_pixel * strip->num_pixels + // 9 * 50 = 450 bytes for WS2812B
+                               strip->protocol->trailer_bytes(strip->num_pixels);
+    strip->data_buf = (uint8_t *) malloc(strip->buffer_size_bytes);
+    strip->linear = (uint16_t (*)[3]) malloc(3 * sizeof(uint16_t) * strip->num_pixels);
+    strip->dither_error = (uint8_t (*)[3]) malloc(3 * strip->num_pixels);
+    strip->black_group = (uint8_t *) malloc(strip->protocol->bytes_per_pixel * LED_PROTOCOL_GROUP_PIXELS);
+    strip->spi_dev = open(config->spi_device);
+
+    if (strip->spi_dev == -1 || strip->data_buf == NULL ||
+        strip->linear == NULL || strip->dither_error == NULL || strip->black_group == NULL) {
+        LOG_ERROR("Failed to set up LED strip %d on %s.", strip->index, config->spi_device);
+        return -1;
+    }
+
+    strip->pixel_buf = strip->data_buf + strip->protocol->header_bytes;
+    strip->protocol->init_frame(strip->data_buf, strip->num_pixels);
+
+    static const uint8_t black[LED_PROTOCOL_GROUP_PIXELS][3] = {{0}};
+    strip->protocol->encode_group(strip->black_group, black);
+
+    if (strip->index > 0) {
+        osThreadAttr_t attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.name = "led_strip";
+        attr.stack_size = LED_STRIP_THREAD_STACK_SIZE;
+        attr.priority = osPriorityAboveNormal;
+
+        strip->output_thread = osThreadNew(led_strip_output_thread, strip, &attr);
+        if (strip->output_thread == NULL) {
+            LOG_ERROR("Failed to start the output thread of LED strip %d.", strip->index);
+            return -1;
+        }
+    }
+
+    /* Start from a validly encoded black frame, which also seeds the frame cache. */
+    led_strip_clear(strip->index);
+    return 0;
+}
+
+
+/********************************************//**
+ *  Called by the one-shot latch timer once the
+ *  line has been low for the reset gap.
+ ***********************************************/
+static void led_strip_latch_elapsed(uint32_t value) {
+    osSemaphoreRelease(g_latch_done);
+}
+
+
+/********************************************//**
+ *  Opens the latch timer. The semaphore holds one
+ *  token while the strips are latched and ready.
+ ***********************************************/
+static int led_strip_latch_init() {
+    g_latch_done = osSemaphoreNew(1, 1, NULL);
+    if (g_latch_done == NULL) {
+        return -1;
+    }
+
+    g_latch_timer_dev = open("tim0");
+    return g_latch_timer_dev == -1 ? -1 : 0;
+}
+
+
+/**
+ * @brief Initialize the LED strips.
+ *
+ * This function sets up every strip declared in led_strip_layout (sysconfig.c).
+ * Their pixels are concatenated in layout order and have to add up to num_pixels.
+ *
+ * @param num_pixels Number of pixels of all LED strips together.
+ * @return 0 on success, -1 on failure.
+ */
+int led_strip_init(int num_pixels) {
+    int result;
+
+    /* Turn on LED */
+    gpio_set_dir(LEDS_POWER_PIN, gpioPinDirOutput);
+    result = gpio_set(LEDS_POWER_PIN, gpioLogicHigh);
+    if (result == -1) {
+        LOG_DEBUG("Failed to turn the LEDS_POWER_PIN to HIGH");
+
+    };
+
+    if (led_strip_latch_init() == -1) {
+        LOG_WARNING("No latch timer, falling back to sending a reset code after each frame.");
+    }
+
+    if (led_strip_layout_count < 1 || led_strip_layout_count > LED_STRIP_MAX_STRIPS) {
+        LOG_ERROR("The LED strip layout must declare 1 to %d strips.", LED_STRIP_MAX_STRIPS);
+        return -1;
+    }
+
+    if (led_strip_layout_count > 1) {
+        g_led_strip_done_flags = osEventFlagsNew(NULL);
+        if (g_led_strip_done_flags == NULL) {
+            return -1;
+        }
+    }
+
+    int first_pixel = 0;
+    for (int i = 0; i < led_strip_layout_count; i++) {
+        g_led_strips[i].index = i;
+        if (led_strip_init_strip(&g_led_strips[i], &led_strip_layout[i], first_pixel) == -1) {
+            return -1;
+        }
+        first_pixel += g_led_strips[i].num_pixels;
+        g_led_strip_count++;
+    }
+
+    if (first_pixel != num_pixels) {
+        LOG_ERROR("The LED strip layout has %d pixels, expected %d.", first_pixel, num_pixels);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Selects the strip that led_strip_set_led() and led_strip_get_num_pixels() refer to.
+ *
+ * @param strip Index of the strip in led_strip_layout.
+ */
+void led_strip_select(int strip) {
+    if (strip >= 0 && strip < g_led_strip_count) {
+        g_selected_strip = &g_led_strips[strip];
+    }
+}
+
+
+/********************************************//**
+ *  Gamma corrects and white balances one pixel into
+ *  the strip's 8.8 fixed point values. The index is
+ *  not bounds checked.
+ ***********************************************/
+static inline void led_strip_linearize_led(struct led_strip *strip, int index, uint8_t red, uint8_t green, uint8_t blue) {
+    uint16_t *linear = strip->linear[index];
+    strip->linear_sum -= linear[0] + linear[1] + linear[2];
+    linear[0] = (uint16_t) ((gamma16[red] * g_led_strip_channel_scale[0]) >> 16);
+    linear[1] = (uint16_t) ((gamma16[green] * g_led_strip_channel_scale[1]) >> 16);
+    linear[2] = (uint16_t) ((gamma16[blue] * g_led_strip_channel_scale[2]) >> 16);
+    strip->linear_sum += linear[0] + linear[1] + linear[2];
+}
+
+/* A pixel dithers while one of its channels falls between two 8 bit steps. */
+static inline bool led_strip_is_dithering(struct led_strip *strip, int index) {
+    const uint16_t *linear = strip->linear[index];
+    return ((linear[0] | linear[1] | linear[2]) & 0xFF) != 0;
+}
+
+
+/* Number of pixels in the group that starts at first, which is short only at the end of the strip. */
+static inline int led_strip_group_size(const struct led_strip *strip, int first) {
+    return std::min(LED_PROTOCOL_GROUP_PIXELS, strip->num_pixels - first);
+}
+
+static inline int led_strip_group_dithering(struct led_strip *strip, int first) {
+    int count = 0;
+    for (int i = first; i < first + led_strip_group_size(strip, first); i++) {
+        count += led_strip_is_dithering(strip, i) ? 1 : 0;
+    }
+    return count;
+}
+
+
+/********************************************//**
+ *  Takes the next 8 bit value of each channel of a
+ *  pixel. The fraction that 8 bits cannot show is
+ *  carried into the following output frames, so on
+ *  average the LED shows the full 16 bit value.
+ *  Pixels that do not dither carry no fraction and
+ *  come out the same every time.
+ ***********************************************/
+static inline void led_strip_dither_step(struct led_strip *strip, int index, uint8_t out[3]) {
+    const uint16_t *linear = strip->linear[index];
+    uint8_t *error = strip->dither_error[index];
+    for (int c = 0; c < 3; c++) {
+        uint32_t value = linear[c] + error[c];
+        out[c] = (uint8_t) (value >> 8);
+        error[c] = (uint8_t) value;
+    }
+}
+
+
+/********************************************//**
+ *  Encodes the next output frame of a group of
+ *  pixels with the strip's protocol.
+ ***********************************************/
+static void led_strip_emit_group(struct led_strip *strip, int first) {
+    uint8_t out[LED_PROTOCOL_GROUP_PIXELS][3];
+    int count = led_strip_group_size(strip, first);
+
+    for (int i = 0; i < count; i++) {
+        led_strip_dither_step(strip, first + i, out[i]);
+    }
+
+    uint8_t *buf = &strip->pixel_buf[strip->protocol->bytes_per_pixel * first];
+    if (count == LED_PROTOCOL_GROUP_PIXELS) {
+        strip->protocol->encode_group(buf, out);
+    } else {
+        for (int i = 0; i < count; i++) {
+            strip->protocol->encode_pixel(buf + strip->protocol->bytes_per_pixel * i, out[i][0], out[i][1], out[i][2]);
+        }
+    }
+}
+
+
+/********************************************//**
+ *  Encodes the next output frame of one pixel, the
+ *  rest of its group keeps its dither step.
+ ***********************************************/
+static void led_strip_emit_pixel(struct led_strip *strip, int index) {
+    uint8_t out[3];
+    led_strip_dither_step(strip, index, out);
+    strip->protocol->encode_pixel(&strip->pixel_buf[strip->protocol->bytes_per_pixel * index], out[0], out[1], out[2]);
+}
+
+
+/********************************************//**
+ *  Gamma corrects one pixel. An exact 8 bit value
+ *  is encoded once, without a leftover fraction.
+ ***********************************************/
+static inline void led_strip_update_led(struct led_strip *strip, int index, uint8_t red, uint8_t green, uint8_t blue) {
+    led_strip_linearize_led(strip, index, red, green, blue);
+    if (!led_strip_is_dithering(strip, index)) {
+        memset(strip->dither_error[index], 0, 3);
+    }
+}
+
+
+/********************************************//**
+ *  Encodes a group into the SPI buffer after its
+ *  pixels were updated. Groups with a dithering
+ *  pixel are encoded by the next
+ *  led_strip_dither_strip() pass.
+ ***********************************************/
+static inline void led_strip_encode_group(struct led_strip *strip, int first) {
+    if (led_strip_group_dithering(strip, first) == 0) {
+        led_strip_emit_group(strip, first);
+    }
+}
+
+
+/********************************************//**
+ *  Advances every dithering pixel of a strip by one
+ *  output frame.
+ ***********************************************/
+static void led_strip_dither_strip(struct led_strip *strip) {
+    for (int first = 0; first < strip->num_pixels; first += LED_PROTOCOL_GROUP_PIXELS) {
+        int dithering = led_strip_group_dithering(strip, first);
+        if (dithering > 0) {
+            led_strip_emit_group(strip, first);
+            g_led_strip_stats.pixels_dithered += dithering;
+            strip->dirty = true;
+        }
+    }
+}
+
+
+/**
+ * @brief Re-encodes the dithering pixels for one more output frame.
+ *
+ * Called between render ticks, followed by update_leds(), so dim colours that fall
+ * between two 8 bit steps are shown by alternating the neighbouring steps without
+ * re-running the filter.
+ */
+void led_strip_dither() {
+    for (int i = 0; i < g_led_strip_count; i++) {
+        led_strip_dither_strip(&g_led_strips[i]);
+    }
+}
+
+
+/**
+ * @brief Sets one pixel of the selected strip.
+ *
+ * @param index Pixel index within the selected strip.
+ * @return 0 on success, -1 if the index is out of range.
+ */
+int led_strip_set_led(uint16_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    struct led_strip *strip = g_selected_strip;
+
+    if (index >= strip->num_pixels) {
+        return -1;
+    }
+
+    frame_buffer_set_rgb(g_front_frame, strip->first_pixel + index, red, green, blue);
+    led_strip_update_led(strip, index, red, green, blue);
+    led_strip_emit_pixel(strip, index);
+    strip->dirty = true;
+    return 0;
+}
+
+
+void led_strip_clear(int strip_index) {
+    if (strip_index < 0 || strip_index >= LED_STRIP_MAX_STRIPS || g_led_strips[strip_index].data_buf == NULL) {
+        return;
+    }
+
+    struct led_strip *strip = &g_led_strips[strip_index];
+    int group_bytes = strip->protocol->bytes_per_pixel * LED_PROTOCOL_GROUP_PIXELS;
+    int pixel_bytes = strip->protocol->bytes_per_pixel * strip->num_pixels;
+
+    /* Block fill with the black group encoded at init, the pattern repeats every pixel. */
+    for (int offset = 0; offset < pixel_bytes; offset += group_bytes) {
+        memcpy(strip->pixel_buf + offset, strip->black_group, std::min(group_bytes, pixel_bytes - offset));
+    }
+    memset(frame_buffer_pixel(g_front_frame, strip->first_pixel), 0, g_front_frame->bytes_per_pixel * strip->num_pixels);
+    memset(strip->linear, 0, 3 * sizeof(uint16_t) * strip->num_pixels);
+    strip->linear_sum = 0;
+    memset(strip->dither_error, 0, 3 * strip->num_pixels);
+    strip->cache_valid = true;
+    strip->dirty = true;
+}
+
+
+static inline bool led_strip_needs_transfer(struct led_strip *strip) {
+    return strip->dirty || ++strip->frames_since_transfer >= LED_STRIP_REFRESH_FRAMES;
+}
+
+static inline void led_strip_transfer_done(struct led_strip *strip) {
+    strip->dirty = false;
+    strip->frames_since_transfer = 0;
+    g_led_strip_stats.transfers++;
+}
+
+
+/**
+ * @brief Switches the supply rail of the strips.
+ *
+ * Before the rail goes down the last frame is given time to latch. After the rail
+ * comes back the LEDs are black whatever was sent before, so every strip is marked
+ * for a transfer.
+ *
+ * @param on true to power the strips.
+ * @return 0 on success, -1 on failure.
+ */
+int led_strip_power(bool on) {
+    if (!on && g_latch_timer_dev != -1) {
+        osSemaphoreAcquire(g_latch_done, osWaitForever);
+        osSemaphoreRelease(g_latch_done);
+    }
+
+    if (gpio_set(LEDS_POWER_PIN, on ? gpioLogicHigh : gpioLogicLow) == -1) {
+        LOG_ERROR("Failed to switch the LEDS_POWER_PIN %s.", on ? "on" : "off");
+        return -1;
+    }
+
+    if (on) {
+        for (int i = 0; i < g_led_strip_count; i++) {
+            g_led_strips[i].dirty = true;
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Sends the SPI buffers to the strips.
+ *
+ * Secondary strips are handed to their output threads and strip 0 is written by the
+ * caller, so the transfers overlap instead of adding up. A strip is skipped when none
+ * of its pixels changed since its last transfer, except for a refresh every
+ * LED_STRIP_REFRESH_FRAMES calls that recovers from glitched frames.
+ *
+ * The WS2812B latch needs the line low for WS2812B_RESET_US after the last bit. A
+ * one-shot timer is started when the transfers are done, and the next transfer waits
+ * for it, so frames can be pushed at any rate without corrupting the latch.
+ */
+void update_leds() {
+    uint32_t pending = 0;
+    bool first_pending = led_strip_needs_transfer(&g_led_strips[0]);
+
+    for (int i = 1; i < g_led_strip_count; i++) {
+        if (led_strip_needs_transfer(&g_led_strips[i])) {
+            pending |= 1U << i;
+        } else {
+            g_led_strip_stats.transfers_skipped++;
+        }
+    }
+
+    if (!first_pending && pending == 0) {
+        g_led_strip_stats.transfers_skipped++;
+        return;
+    }
+
+    /* Wait until the previous frame has latched. */
+    if (g_latch_timer_dev != -1) {
+        osSemaphoreAcquire(g_latch_done, osWaitForever);
+    }
+
+    for (int i = 1; i < g_led_strip_count; i++) {
+        if (pending & (1U << i)) {
+            osThreadFlagsSet(g_led_strips[i].output_thread, LED_STRIP_FLAG_TRANSFER);
+        }
+    }
+
+    struct led_strip *first = &g_led_strips[0];
+    if (first_pending) {
+        spi_write(first->spi_dev, first->data_buf, first->buffer_size_bytes);
+        if (g_latch_timer_dev == -1) {
+            spi_write(first->spi_dev, nulls, RESET_CODE_LENGTH);
+        }
+        led_strip_transfer_done(first);
+    } else {
+        g_led_strip_stats.transfers_skipped++;
+    }
+
+    if (pending != 0) {
+        osEventFlagsWait(g_led_strip_done_flags, pending, osFlagsWaitAll, osWaitForever);
+        for (int i = 1; i < g_led_strip_count; i++) {
+            if (pending & (1U << i)) {
+                led_strip_transfer_done(&g_led_strips[i]);
+            }
+        }
+    }
+
+    /* The last bit of every strip has left, start timing the reset gap. The LEDs show the
+     * frame once it has passed, without the latch timer the reset code has been sent already. */
+    g_led_strip_latch_sys = osKernelGetSysTimerCount();
+    if (g_latch_timer_dev != -1) {
+        g_led_strip_latch_sys += (uint32_t) (((uint64_t) WS2812B_RESET_US * osKernelGetSysTimerFreq()) / 1000000U);
+    }
+    if (g_latch_timer_dev != -1 && timer_start(g_latch_timer_dev, TIMER_TYPE_ONCE, LATCH_TIMER_FREQUENCY_HZ, led_strip_latch_elapsed) < 0) {
+        osSemaphoreRelease(g_latch_done);
+    }
+}
+
+
+/********************************************//**
+ *  Folds the white balance and the brightness of
+ *  the current limiter into one Q16 multiplier per
+ *  channel, applied in led_strip_linearize_led().
+ ***********************************************/
+static void led_strip_update_channel_scale() {
+    for (int c = 0; c < 3; c++) {
+        g_led_strip_channel_scale[c] = (uint32_t) (g_led_strip_color_bal[c] * (float) g_led_strip_brightness);
+    }
+}
+
+
+void led_strip_white_balance(float r, float g, float b) {
+    if (IS_NORMALIZED(r) && IS_NORMALIZED(g) && IS_NORMALIZED(b)) {
+        g_led_strip_color_bal[0] = r;
+        g_led_strip_color_bal[1] = g;
+        g_led_strip_color_bal[2] = b;
+        led_strip_update_channel_scale();
+
+        /* Every pixel's encoding changes, so the next frame is re-encoded in full. */
+        for (int i = 0; i < g_led_strip_count; i++) {
+            g_led_strips[i].cache_valid = false;
+        }
+    }
+}
+
+int led_strip_get_num_pixels() {
+    return g_selected_strip->num_pixels;
+}
+
+
+void led_strip_get_stats(struct led_strip_stats *stats) {
+    *stats = g_led_strip_stats;
+}
+
+/**
+ * @brief System timer count at which the frame of the last update_leds() that sent
+ * anything latches, i.e. the LEDs start to show it. It can lie in the future.
+ */
+uint32_t led_strip_latch_time() {
+    return g_led_strip_latch_sys;
+}
+
+void led_strip_reset_stats() {
+    uint32_t current_ma = g_led_strip_stats.current_ma;
+    memset(&g_led_strip_stats, 0, sizeof(g_led_strip_stats));
+    g_led_strip_stats.current_ma = current_ma;
+    g_led_strip_stats.brightness = g_led_strip_brightness;
+}
+
+
+/********************************************//**
+ *  Compares a group of four pixels as words, one
+ *  word per byte of a pixel. Cortex-M33 handles
+ *  the unaligned loads.
+ ***********************************************/
+static inline bool led_group_equal(const uint8_t *a, const uint8_t *b, int bytes_per_pixel) {
+    uint32_t diff = 0;
+    for (int i = 0; i < bytes_per_pixel; i++) {
+        uint32_t word_a;
+        uint32_t word_b;
+        memcpy(&word_a, a + 4 * i, sizeof(word_a));
+        memcpy(&word_b, b + 4 * i, sizeof(word_b));
+        diff |= word_a ^ word_b;
+    }
+    return diff == 0;
+}
+
+static inline bool led_strip_update_if_changed(struct led_strip *strip, const FrameBuffer *frame, int index) {
+    const uint8_t *pixel = frame->pixels + frame->bytes_per_pixel * (strip->first_pixel + index);
+    const uint8_t *last = g_front_frame->pixels + frame->bytes_per_pixel * (strip->first_pixel + index);
+    if (memcmp(pixel, last, frame->bytes_per_pixel) == 0) {
+        g_led_strip_stats.pixels_skipped++;
+        return false;
+    }
+
+    uint8_t red, green, blue;
+    frame_buffer_get_rgb(frame, strip->first_pixel + index, &red, &green, &blue);
+    led_strip_update_led(strip, index, red, green, blue);
+    g_led_strip_stats.pixels_encoded++;
+    return true;
+}
+
+
+/********************************************//**
+ *  Re-encodes the groups of one strip that differ
+ *  from the front frame.
+ ***********************************************/
+static void led_strip_set_frame(struct led_strip *strip, const FrameBuffer *frame) {
+    int bytes_per_pixel = frame->bytes_per_pixel;
+
+    if (!strip->cache_valid) {
+        for (int i = 0; i < strip->num_pixels; i++) {
+            uint8_t red, green, blue;
+            frame_buffer_get_rgb(frame, strip->first_pixel + i, &red, &green, &blue);
+            led_strip_update_led(strip, i, red, green, blue);
+        }
+        for (int i = 0; i < strip->num_pixels; i += LED_PROTOCOL_GROUP_PIXELS) {
+            led_strip_encode_group(strip, i);
+        }
+        g_led_strip_stats.pixels_encoded += strip->num_pixels;
+        strip->cache_valid = true;
+        strip->dirty = true;
+        return;
+    }
+
+    for (int i = 0; i < strip->num_pixels; i += LED_PROTOCOL_GROUP_PIXELS) {
+        int count = std::min(LED_PROTOCOL_GROUP_PIXELS, strip->num_pixels - i);
+        int offset = bytes_per_pixel * (strip->first_pixel + i);
+        if (count == LED_PROTOCOL_GROUP_PIXELS &&
+            led_group_equal(frame->pixels + offset, g_front_frame->pixels + offset, bytes_per_pixel)) {
+            g_led_strip_stats.pixels_skipped += LED_PROTOCOL_GROUP_PIXELS;
+            continue;
+        }
+
+        bool changed = false;
+        for (int j = i; j < i + count; j++) {
+            changed |= led_strip_update_if_changed(strip, frame, j);
+        }
+        if (changed) {
+            led_strip_encode_group(strip, i);
+            strip->dirty = true;
+        }
+    }
+}
+
+
+/********************************************//**
+ *  Current the lit channels of all strips draw, in
+ *  mA. A channel at full value (255.0 in 8.8) draws
+ *  the protocol's channel_ma.
+ ***********************************************/
+static uint32_t led_strip_estimate_led_ma() {
+    uint32_t led_ma = 0;
+    for (int i = 0; i < g_led_strip_count; i++) {
+        const struct led_strip *strip = &g_led_strips[i];
+        led_ma += (uint32_t) (((uint64_t) strip->linear_sum * strip->protocol->channel_ma) / 65280U);
+    }
+    return led_ma;
+}
+
+
+/********************************************//**
+ *  Keeps the estimated current of the frame within
+ *  LED_STRIP_CURRENT_BUDGET_MA. An over budget frame
+ *  is dimmed with one brightness multiply, folded
+ *  into the channel scale, and re-encoded. Once the
+ *  frame fits again the brightness creeps back up,
+ *  as far as the headroom allows. Every change
+ *  re-encodes all strips, so the limiter dims a
+ *  hysteresis below the budget and ignores steps
+ *  back up smaller than the hysteresis.
+ ***********************************************/
+static void led_strip_limit_current() {
+    uint32_t idle_ma = 0;
+    for (int i = 0; i < g_led_strip_count; i++) {
+        idle_ma += (uint32_t) g_led_strips[i].num_pixels * g_led_strips[i].protocol->idle_ua / 1000U;
+    }
+
+    /* The quiescent current cannot be dimmed, the lit channels share what is left. */
+    uint32_t budget_ma = LED_STRIP_CURRENT_BUDGET_MA > idle_ma ? LED_STRIP_CURRENT_BUDGET_MA - idle_ma : 0;
+    uint32_t brightness = g_led_strip_brightness;
+    uint32_t led_ma = led_strip_estimate_led_ma();
+    uint32_t request_ma = idle_ma + (uint32_t) (((uint64_t) led_ma << 16) / brightness);
+    uint32_t target = brightness;
+
+    if (request_ma > g_led_strip_stats.peak_request_ma) {
+        g_led_strip_stats.peak_request_ma = request_ma;
+    }
+
+    if (led_ma > budget_ma) {
+        target = (uint32_t) (((uint64_t) brightness * budget_ma) / led_ma);
+        target = target > LED_STRIP_BRIGHTNESS_HYSTERESIS ? target - LED_STRIP_BRIGHTNESS_HYSTERESIS : 0;
+        g_led_strip_stats.limited_frames++;
+    } else if (brightness < 65536U) {
+        target = std::min(brightness + LED_STRIP_BRIGHTNESS_RECOVERY, 65536U);
+        if (led_ma > 0 && ((uint64_t) led_ma * target) / brightness > budget_ma) {
+            target = (uint32_t) (((uint64_t) brightness * budget_ma) / led_ma);
+        }
+        if (target < 65536U && target - brightness < LED_STRIP_BRIGHTNESS_HYSTERESIS) {
+            target = brightness;
+        }
+    }
+    target = std::max(target, (uint32_t) LED_STRIP_BRIGHTNESS_MIN);
+
+    if (target != brightness) {
+        g_led_strip_brightness = target;
+        led_strip_update_channel_scale();
+
+        for (int i = 0; i < g_led_strip_count; i++) {
+            struct led_strip *strip = &g_led_strips[i];
+            for (int j = 0; j < strip->num_pixels; j++) {
+                uint8_t red, green, blue;
+                frame_buffer_get_rgb(g_front_frame, strip->first_pixel + j, &red, &green, &blue);
+                led_strip_update_led(strip, j, red, green, blue);
+            }
+            for (int j = 0; j < strip->num_pixels; j += LED_PROTOCOL_GROUP_PIXELS) {
+                led_strip_encode_group(strip, j);
+            }
+            g_led_strip_stats.pixels_encoded += strip->num_pixels;
+            strip->dirty = true;
+        }
+        led_ma = led_strip_estimate_led_ma();
+    }
+
+    g_led_strip_stats.current_ma = idle_ma + led_ma;
+    g_led_strip_stats.brightness = target;
+}
+
+
+/**
+ * @brief Returns the frame to render the next frame into.
+ *
+ * The frame holds NUM_PIXELS pixels in LED_STRIP_PIXEL_FORMAT. Its content is
+ * undefined, a filter has to write every pixel before led_strip_submit_frame().
+ */
+FrameBuffer *led_strip_frame() {
+    return g_back_frame;
+}
+
+
+/**
+ * @brief Submits the frame returned by led_strip_frame() to the strips.
+ *
+ * The frame is split across the strips in layout order. Only pixels that differ from
+ * the previously submitted frame are gamma corrected and re-encoded. Unchanged groups
+ * of four pixels are rejected with word compares. Dithering pixels advance by one
+ * output frame. Frames that would draw more than LED_STRIP_CURRENT_BUDGET_MA are
+ * dimmed as a whole.
+ */
+void led_strip_submit_frame() {
+    g_led_strip_stats.frames++;
+
+    for (int i = 0; i < g_led_strip_count; i++) {
+        led_strip_set_frame(&g_led_strips[i], g_back_frame);
+    }
+
+    FrameBuffer *shown = g_back_frame;
+    g_back_frame = g_front_frame;
+    g_front_frame = shown;
+
+    led_strip_limit_current();
+    led_strip_dither();
+}
+
+void clear_leds() {
+    frame_buffer_fill(g_back_frame, 0, 0, 0);
+    led_strip_submit_frame();
+}
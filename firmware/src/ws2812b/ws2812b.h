@@ -10,18 +10,58 @@
 #define _LED_STRIP_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "led_protocol.h"
+#include "frame_buffer.h"
 
 #if defined (__cplusplus)
 extern "C" {
 #endif
+
+/**
+ * @brief One entry of the strip layout.
+ */
+struct led_strip_config {
+    const char *spi_device;     ///< name of the SPI device in sysconfig.c that drives the strip
+    int num_pixels;             ///< number of pixels on the strip
+    const struct led_protocol *protocol; ///< chipset of the strip, see led_protocol.h
+};
+
+/* The strip layout, declared in sysconfig.c. Pixels are numbered across strips in this order. */
+extern const struct led_strip_config led_strip_layout[];
+extern const int led_strip_layout_count;
+
+/**
+ * @brief Counters of the driver's dirty tracking, to see what each filter costs.
+ */
+struct led_strip_stats {
+    uint32_t frames;            ///< frames submitted with led_strip_submit_frame()
+    uint32_t pixels_encoded;    ///< pixels that changed and were re-encoded
+    uint32_t pixels_skipped;    ///< pixels that were unchanged and kept their encoding
+    uint32_t pixels_dithered;   ///< pixels re-encoded for the next dither step
+    uint32_t transfers;         ///< SPI transfers sent by update_leds()
+    uint32_t transfers_skipped; ///< strip transfers skipped because nothing changed
+    uint32_t current_ma;        ///< estimated current of the last frame, after limiting
+    uint32_t peak_request_ma;   ///< highest current a frame asked for before limiting
+    uint32_t limited_frames;    ///< frames the brightness limiter had to dim
+    uint32_t brightness;        ///< brightness of the last frame in Q16, 65536 is full
+};
+
 int led_strip_init(int num_pixels);
 void led_strip_white_balance (float r, float g, float b);
 int  led_strip_set_led(uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
 int  led_strip_get_num_pixels();
+void led_strip_clear(int strip);
+int  led_strip_power(bool on);
 void update_leds();
+void led_strip_dither();
 void led_strip_select (int strip);
-void set_leds(uint8_t (*virtual_leds)[3]);
-void clear_leds(uint8_t (*virtual_leds)[3]);
+FrameBuffer *led_strip_frame();
+void led_strip_submit_frame();
+void clear_leds();
+void led_strip_get_stats(struct led_strip_stats *stats);
+void led_strip_reset_stats();
+uint32_t led_strip_latch_time();
 
 
 #if defined (__cplusplus)
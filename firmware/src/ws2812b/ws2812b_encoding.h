@@ -0,0 +1,279 @@
+/*
+ * File: ws2812b_encoding.h
+ * Description: The SPI bit encodings of the WS2812B driver.
+ *
+ * The WS2812B reads a single data line, on which every bit is a high pulse followed
+ * by a low pulse, and the length of the high pulse tells a 0 from a 1. The driver
+ * reproduces these pulses with the MOSI line of an SPI peripheral: each data bit is
+ * sent as a symbol of several SPI bits that starts with a run of ones.
+ *
+ * The SK6812 uses the same scheme with its own pulse widths.
+ *
+ * Every encoding provides the same interface:
+ *  - BYTES_PER_CHANNEL: SPI bytes produced per colour byte
+ *  - encode_channels(out, channels, count): encodes count colour bytes, already
+ *    gamma corrected and in wire order, into out
+ *
+ * The encoding is selected at compile time with WS2812B_ENCODING in globals.h. The
+ * timing of the selected encoding at SPI_BAUDRATE is checked against the datasheet
+ * at compile time, so the fastest encoding a board tolerates can be picked safely.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "globals.h"
+
+#define WS2812B_ENCODING_3BIT      (0) // 3 SPI bits per data bit, 9 bytes per pixel, byte table
+#define WS2812B_ENCODING_4BIT      (1) // 4 SPI bits per data bit, 12 bytes per pixel, for faster baudrates
+#define WS2812B_ENCODING_3BIT_WORD (2) // the 3 bit stream, built from 32 bit table entries and written as words
+
+#define WS2812B_SYMBOL_TABLE_SIZE (256)
+
+
+/**
+ * @brief Datasheet pulse widths of a one-wire LED chip, in ns.
+ */
+struct OneWireTiming {
+    uint16_t t0h_min, t0h_max;
+    uint16_t t1h_min, t1h_max;
+    uint16_t t0l_min, t0l_max;
+    uint16_t t1l_min, t1l_max;
+};
+
+/* WS2812B: T0H 0.4 us, T1H 0.8 us, T0L 0.85 us, T1L 0.45 us, each +-150 ns */
+constexpr OneWireTiming WS2812B_TIMING = {250, 550, 650, 950, 700, 1000, 300, 600};
+/* SK6812: T0H 0.3 us, T1H 0.6 us, T0L 0.9 us, T1L 0.6 us, each +-150 ns */
+constexpr OneWireTiming SK6812_TIMING = {150, 450, 450, 750, 750, 1050, 450, 750};
+
+
+/**
+ * @brief Describes the symbols of an encoding.
+ *
+ * A data bit is sent as symbol_bits SPI bits, of which the first zero_high_bits
+ * (for a 0) or one_high_bits (for a 1) are high.
+ */
+template<int symbol_bits, int zero_high_bits, int one_high_bits>
+struct Ws2812bSymbols {
+    static constexpr int SYMBOL_BITS = symbol_bits;
+    static constexpr int ZERO_HIGH_BITS = zero_high_bits;
+    static constexpr int ONE_HIGH_BITS = one_high_bits;
+    static constexpr int BYTES_PER_CHANNEL = symbol_bits; // 8 data bits * symbol_bits / 8
+
+    /* The SPI bits of one colour byte, MSB first, right aligned. */
+    static constexpr uint32_t encode_value(int value) {
+        uint32_t bits = 0;
+        for (int bit = 7; bit >= 0; bit--) {
+            int high_bits = ((value >> bit) & 1) ? one_high_bits : zero_high_bits;
+            bits = (bits << symbol_bits) | (((1U << high_bits) - 1) << (symbol_bits - high_bits));
+        }
+        return bits;
+    }
+};
+
+
+/* Hand-written bit patterns of the 3 bit encoding. The most significant byte covers
+ * data bits 7-5, the medium bits 4-3 and the least bits 2-0. */
+constexpr uint8_t most_significant_byte[] = {
+        0x92, // 100 100 10
+        0x93, // 100 100 11
+        0x9A, // 100 110 10
+        0x9B, // 100 110 11
+        0xD2, // 110 100 10
+        0XD3, // 110 100 11
+        0xDA, // 110 110 10
+        0xDB, // 110 110 11 *double-checked
+};
+
+
+constexpr uint8_t med_significant_byte[] = {
+        0x49, // 0 100 100 1
+        0X4D, // 0 100 110 1
+        0x69, // 0 110 100 1
+        0x6D, // 0 110 110 1 *double-checked
+};
+
+constexpr uint8_t least_significant_byte[] = {
+        0x24, // 00 100 100
+        0x26, // 00 100 110
+        0x34, // 00 110 100
+        0x36, // 00 110 110
+        0xA4, // 10 100 100
+        0XA6, // 10 100 110
+        0xB4, // 10 110 100
+        0xB6, // 10 110 110 *double-checked
+};
+
+
+using Ws2812bSymbols3Bit = Ws2812bSymbols<3, 1, 2>;
+
+struct SpiLookupTable {
+    uint8_t symbol[WS2812B_SYMBOL_TABLE_SIZE][3];
+};
+
+/* Builds the lookup table at compile time, in-which each index
+ * corresponds to the SPI bit signal that will transmit the uint8_t value. */
+constexpr SpiLookupTable make_spi_lookup_table() {
+    SpiLookupTable table = {};
+    for (int value = 0; value < WS2812B_SYMBOL_TABLE_SIZE; value++) {
+        uint32_t bits = Ws2812bSymbols3Bit::encode_value(value);
+        table.symbol[value][0] = (uint8_t) (bits >> 16);
+        table.symbol[value][1] = (uint8_t) (bits >> 8);
+        table.symbol[value][2] = (uint8_t) bits;
+    }
+    return table;
+}
+
+/**
+ * @brief 3 SPI bits per data bit, 100 for a 0 and 110 for a 1.
+ *
+ * At 2.5 MHz a 0 is high for 400 ns and a 1 for 800 ns. Each colour byte is copied
+ * from a 256x3 byte table.
+ */
+struct Ws2812bEncoder3Bit : Ws2812bSymbols3Bit {
+    /* const and constant-initialized, so the table is placed in flash. */
+    static constexpr SpiLookupTable table = make_spi_lookup_table();
+
+    static inline void encode_channels(uint8_t *out, const uint8_t *channels, int count) {
+        for (int i = 0; i < count; i++) {
+            memcpy(out, table.symbol[channels[i]], 3);
+            out += 3;
+        }
+    }
+};
+
+
+template<typename Symbols>
+struct NibbleLookupTable {
+    uint16_t symbol[16];
+};
+
+template<typename Symbols>
+constexpr NibbleLookupTable<Symbols> make_nibble_lookup_table() {
+    NibbleLookupTable<Symbols> table = {};
+    for (int nibble = 0; nibble < 16; nibble++) {
+        table.symbol[nibble] = (uint16_t) Symbols::encode_value(nibble);
+    }
+    return table;
+}
+
+/**
+ * @brief 4 SPI bits per data bit, built from a 16 entry table per data nibble.
+ */
+template<typename Symbols>
+struct Ws2812bNibbleEncoder : Symbols {
+    static_assert(Symbols::SYMBOL_BITS == 4, "the nibble encoder needs 4 bit symbols");
+
+    static constexpr NibbleLookupTable<Symbols> table = make_nibble_lookup_table<Symbols>();
+
+    static inline void encode_channels(uint8_t *out, const uint8_t *channels, int count) {
+        for (int i = 0; i < count; i++) {
+            uint16_t high = table.symbol[channels[i] >> 4];
+            uint16_t low = table.symbol[channels[i] & 0x0F];
+            out[0] = (uint8_t) (high >> 8);
+            out[1] = (uint8_t) high;
+            out[2] = (uint8_t) (low >> 8);
+            out[3] = (uint8_t) low;
+            out += 4;
+        }
+    }
+};
+
+/* 1000 for a 0 and 1110 for a 1. Meant for baudrates around 3.2 MHz,
+ * where a 0 is high for 312 ns and a 1 for 937 ns. */
+using Ws2812bEncoder4Bit = Ws2812bNibbleEncoder<Ws2812bSymbols<4, 1, 3>>;
+
+/* The SK6812 wants a shorter 1: 1000 for a 0 and 1100 for a 1 at around 3.2 MHz. */
+using Sk6812Encoder = Ws2812bNibbleEncoder<Ws2812bSymbols<4, 1, 2>>;
+
+
+struct WordLookupTable {
+    uint32_t symbol[WS2812B_SYMBOL_TABLE_SIZE];
+};
+
+constexpr WordLookupTable make_word_lookup_table() {
+    WordLookupTable table = {};
+    for (int value = 0; value < WS2812B_SYMBOL_TABLE_SIZE; value++) {
+        table.symbol[value] = Ws2812bSymbols3Bit::encode_value(value);
+    }
+    return table;
+}
+
+/**
+ * @brief The 3 bit encoding, written as 32 bit words.
+ *
+ * Each table entry holds the 24 SPI bits of a colour byte. Four colour bytes are
+ * packed into three words, byte swapped into wire order (REV on Cortex-M33) and
+ * stored with one word store each, instead of twelve byte moves.
+ */
+struct Ws2812bEncoder3BitWord : Ws2812bSymbols3Bit {
+    static constexpr WordLookupTable table = make_word_lookup_table();
+
+    static inline void store_word(uint8_t *out, uint32_t word) {
+        word = __builtin_bswap32(word);
+        memcpy(out, &word, sizeof(word));
+    }
+
+    static inline void encode_channels(uint8_t *out, const uint8_t *channels, int count) {
+        for (; count >= 4; count -= 4) {
+            uint32_t s0 = table.symbol[channels[0]];
+            uint32_t s1 = table.symbol[channels[1]];
+            uint32_t s2 = table.symbol[channels[2]];
+            uint32_t s3 = table.symbol[channels[3]];
+            store_word(out + 0, (s0 << 8) | (s1 >> 16));
+            store_word(out + 4, (s1 << 16) | (s2 >> 8));
+            store_word(out + 8, (s2 << 24) | s3);
+            channels += 4;
+            out += 12;
+        }
+        for (; count > 0; count--) {
+            uint32_t s = table.symbol[*channels++];
+            out[0] = (uint8_t) (s >> 16);
+            out[1] = (uint8_t) (s >> 8);
+            out[2] = (uint8_t) s;
+            out += 3;
+        }
+    }
+};
+
+
+#if WS2812B_ENCODING == WS2812B_ENCODING_3BIT
+using Ws2812bEncoder = Ws2812bEncoder3Bit;
+#elif WS2812B_ENCODING == WS2812B_ENCODING_4BIT
+using Ws2812bEncoder = Ws2812bEncoder4Bit;
+#elif WS2812B_ENCODING == WS2812B_ENCODING_3BIT_WORD
+using Ws2812bEncoder = Ws2812bEncoder3BitWord;
+#else
+#error "Unknown WS2812B_ENCODING"
+#endif
+
+
+/* Checks that the pulses of an encoding at the given baudrate fall into the datasheet windows. */
+template<typename Encoder>
+constexpr bool one_wire_timing_valid(const OneWireTiming &timing, uint32_t baudrate) {
+    double bit_ns = 1e9 / baudrate;
+    double t0h = Encoder::ZERO_HIGH_BITS * bit_ns;
+    double t1h = Encoder::ONE_HIGH_BITS * bit_ns;
+    double t0l = (Encoder::SYMBOL_BITS - Encoder::ZERO_HIGH_BITS) * bit_ns;
+    double t1l = (Encoder::SYMBOL_BITS - Encoder::ONE_HIGH_BITS) * bit_ns;
+    return t0h >= timing.t0h_min && t0h <= timing.t0h_max &&
+           t1h >= timing.t1h_min && t1h <= timing.t1h_max &&
+           t0l >= timing.t0l_min && t0l <= timing.t0l_max &&
+           t1l >= timing.t1l_min && t1l <= timing.t1l_max;
+}
+
+/* Cross-check the generated 3 bit symbols against the hand-written bit patterns. */
+constexpr bool ws2812b_3bit_table_matches_patterns() {
+    for (int value = 0; value < WS2812B_SYMBOL_TABLE_SIZE; value++) {
+        if (Ws2812bEncoder3Bit::table.symbol[value][0] != most_significant_byte[value >> 5] ||
+            Ws2812bEncoder3Bit::table.symbol[value][1] != med_significant_byte[(value >> 3) & 0x03] ||
+            Ws2812bEncoder3Bit::table.symbol[value][2] != least_significant_byte[value & 0x07]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(sizeof(Ws2812bEncoder3Bit::table.symbol) == WS2812B_SYMBOL_TABLE_SIZE * 3, "SPI lookup table must cover every uint8_t value");
+static_assert(ws2812b_3bit_table_matches_patterns(), "SPI lookup table does not match the WS2812B bit patterns");
+static_assert(one_wire_timing_valid<Ws2812bEncoder>(WS2812B_TIMING, SPI_BAUDRATE), "SPI_BAUDRATE is outside the WS2812B timing tolerance of WS2812B_ENCODING");
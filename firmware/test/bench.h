@@ -0,0 +1,33 @@
+/*
+ * File: bench.h
+ * Description: Timing helpers for the host benchmarks, see CMakeLists.txt.
+ *
+ * Host numbers only rank implementations against each other. Cycle counts on the
+ * target come from the profiler, see profiler/profiler.h.
+ */
+#pragma once
+#include <algorithm>
+#include <chrono>
+
+#define BENCH_RUNS (15)
+
+/* Keeps the compiler from dropping work whose result is not used otherwise. */
+template<typename T>
+static inline void bench_keep(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * @brief Runs body BENCH_RUNS times and returns the fastest run in ns per item.
+ */
+template<typename Body>
+static double bench_ns_per_item(long items, Body body) {
+    double best = 1e30;
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / items);
+    }
+    return best;
+}
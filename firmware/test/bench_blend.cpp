@@ -0,0 +1,143 @@
+/*
+ * File: bench_blend.cpp
+ * Description: Checks and times the crossfade of ws2812b/frame_buffer.h and the
+ * blend modes of utils/blend_simd.h.
+ *
+ * frame_buffer_blend() has to match the scalar lerp (from * (256 - w) + dst * w) >> 8
+ * bit for bit, for every weight, every pixel format and frame lengths that leave a
+ * partial word at the end. The blend modes have to match blend_reference.h, here on
+ * the portable path, the DSP path is checked by test_blend_dsp.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "ws2812b/frame_buffer.h"
+#include "blend_reference.h"
+#include "host_test.h"
+#include "bench.h"
+
+#define BENCH_PIXELS (1024)
+#define BENCH_FRAMES (200)
+
+
+static void scalar_blend(uint8_t *dst, const uint8_t *from, int bytes, uint32_t weight) {
+    for (int i = 0; i < bytes; i++) {
+        dst[i] = (uint8_t) ((from[i] * (256U - weight) + dst[i] * weight) >> 8);
+    }
+}
+
+
+static void test_crossfade() {
+    std::vector<uint8_t> from(4 * 53), dst(4 * 53), expected(4 * 53);
+    int mismatches = 0;
+
+    for (int bytes_per_pixel = 3; bytes_per_pixel <= 4; bytes_per_pixel++) {
+        for (int num_pixels = 1; num_pixels <= 53; num_pixels += 13) {
+            int bytes = bytes_per_pixel * num_pixels;
+            for (uint32_t weight = 0; weight <= 256; weight++) {
+                for (int i = 0; i < bytes; i++) {
+                    from[i] = (uint8_t) rand();
+                    dst[i] = expected[i] = (uint8_t) rand();
+                }
+                FrameBuffer dst_frame = {bytes_per_pixel == 4 ? PIXEL_FORMAT_RGBW8888 : PIXEL_FORMAT_RGB888,
+                                         bytes_per_pixel, num_pixels, dst.data()};
+                FrameBuffer from_frame = dst_frame;
+                from_frame.pixels = from.data();
+
+                scalar_blend(expected.data(), from.data(), bytes, weight);
+                frame_buffer_blend(&dst_frame, &from_frame, weight);
+                mismatches += memcmp(dst.data(), expected.data(), bytes) != 0;
+            }
+        }
+    }
+    CHECK(mismatches == 0, "%d blends differ from the scalar lerp", mismatches);
+}
+
+
+static void bench_crossfade() {
+    std::vector<uint8_t> from(3 * BENCH_PIXELS), dst(3 * BENCH_PIXELS);
+    for (int i = 0; i < 3 * BENCH_PIXELS; i++) {
+        from[i] = (uint8_t) rand();
+        dst[i] = (uint8_t) rand();
+    }
+    FrameBuffer dst_frame = {PIXEL_FORMAT_RGB888, 3, BENCH_PIXELS, dst.data()};
+    FrameBuffer from_frame = {PIXEL_FORMAT_RGB888, 3, BENCH_PIXELS, from.data()};
+
+    double scalar_ns = bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            scalar_blend(dst.data(), from.data(), 3 * BENCH_PIXELS, (uint32_t) frame & 0xFF);
+            bench_keep(dst[0]);
+        }
+    });
+    double word_ns = bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            frame_buffer_blend(&dst_frame, &from_frame, (uint32_t) frame & 0xFF);
+            bench_keep(dst[0]);
+        }
+    });
+    printf("crossfade: scalar %.2f ns/pixel, frame_buffer_blend %.2f ns/pixel\n", scalar_ns, word_ns);
+}
+
+
+static void test_modes() {
+    static const BlendMode modes[] = {BLEND_MODE_ALPHA, BLEND_MODE_ADD, BLEND_MODE_MULTIPLY, BLEND_MODE_SCREEN};
+
+    for (BlendMode mode : modes) {
+        int mismatches = 0;
+        for (uint32_t x = 0; x < 256; x++) {
+            for (uint32_t y = 0; y < 256; y++) {
+                mismatches += reference_check_word(x * 0x01010101U, y * 0x01010101U, mode, 256);
+            }
+        }
+        for (uint32_t weight = 0; weight <= 256; weight++) {
+            for (int i = 0; i < 1000; i++) {
+                uint32_t dst = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+                uint32_t src = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+                mismatches += reference_check_word(dst, src, mode, weight);
+            }
+        }
+        CHECK(mismatches == 0, "mode %d: %d bytes differ from the reference", mode, mismatches);
+    }
+}
+
+
+/* The layer modes of the compositor at a weight below 256, so the lerp runs as well. */
+static void bench_modes() {
+    static const BlendMode modes[] = {BLEND_MODE_MULTIPLY, BLEND_MODE_SCREEN};
+    static const char *const names[] = {"multiply", "screen"};
+    std::vector<uint8_t> src(3 * BENCH_PIXELS), dst(3 * BENCH_PIXELS);
+    for (int i = 0; i < 3 * BENCH_PIXELS; i++) {
+        src[i] = (uint8_t) rand();
+        dst[i] = (uint8_t) rand();
+    }
+
+    for (int m = 0; m < 2; m++) {
+        double scalar_ns = bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+            for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+                for (int i = 0; i < 3 * BENCH_PIXELS; i++) {
+                    dst[i] = reference_blend(dst[i], src[i], modes[m], 200);
+                }
+                bench_keep(dst[0]);
+            }
+        });
+        double word_ns = bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+            for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+                blend_bytes(dst.data(), src.data(), 3 * BENCH_PIXELS, modes[m], 200);
+                bench_keep(dst[0]);
+            }
+        });
+        printf("%s: scalar %.2f ns/pixel, blend_bytes %.2f ns/pixel\n", names[m], scalar_ns, word_ns);
+    }
+}
+
+
+int main() {
+    srand(1);
+    test_crossfade();
+    test_modes();
+    bench_crossfade();
+    bench_modes();
+    return host_test_result();
+}
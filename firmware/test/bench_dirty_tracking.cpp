@@ -0,0 +1,175 @@
+/*
+ * File: bench_dirty_tracking.cpp
+ * Description: What the dirty tracking of the LED strip driver saves for each
+ * registered filter, against re-encoding and resending every pixel in every slot.
+ *
+ * Each filter runs BENCH_SECONDS of a simulated ride through the real driver
+ * (ws2812b/ws2812b.cpp on the drivers of host_drivers.cpp), slot by slot as the
+ * main loop runs it: a render slot per frame, then subframe slots that render
+ * again or only dither. The crossfade into the filter is not counted. The bytes
+ * encoded are counted in the encoders of a WS2812B backend the strip runs on, the
+ * bytes sent at the SPI device. A full refresh encodes and sends the whole strip in
+ * every slot.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include "filter_handler/filter_handler.h"
+#include "ws2812b/ws2812b.h"
+#include "ws2812b/led_protocol.h"
+#include "wheel_phase/wheel_phase.h"
+#include "utils/map_value.h"
+#include "kernel.h"
+#include "globals.h"
+#include "host_drivers.h"
+#include "host_test.h"
+
+#define BENCH_SECONDS (10)
+#define BENCH_TIMER_HZ (39000000.0)
+#define BENCH_TICK_HZ (1000)
+
+/* Sensor data, defined in main.cpp on the target. */
+float accel_data[3];
+float gyro_data[3];
+float smooth_accel_data[3];
+float smooth_gyro_data[3];
+uint8_t mapped_accel_data[3];
+uint8_t mapped_gyro_data[3];
+uint8_t magnitude_mapped_accel_data;
+uint8_t magnitude_mapped_gyro_data;
+
+/* led_protocol_ws2812b with encoders that count the bytes they write, set up in main(). */
+static struct led_protocol g_counting_ws2812b;
+static uint64_t g_encoded_bytes = 0;
+
+extern "C" const struct led_strip_config led_strip_layout[] = {{"spi0", NUM_PIXELS, &g_counting_ws2812b}};
+extern "C" const int led_strip_layout_count = 1;
+
+static double g_now_s = 0;
+
+uint32_t osKernelGetSysTimerCount(void) {
+    return (uint32_t) (uint64_t) llround(g_now_s * BENCH_TIMER_HZ);
+}
+
+uint32_t osKernelGetSysTimerFreq(void) {
+    return (uint32_t) BENCH_TIMER_HZ;
+}
+
+uint32_t osKernelGetTickCount(void) {
+    return (uint32_t) (uint64_t) (g_now_s * BENCH_TICK_HZ);
+}
+
+uint32_t osKernelGetTickFreq(void) {
+    return BENCH_TICK_HZ;
+}
+
+
+/********************************************//**
+ *  Samples the ICM on a ride that speeds up and
+ *  slows down, with sensor noise, and processes
+ *  the data as process_data() in main.cpp does.
+ ***********************************************/
+static void sample_sensors() {
+    double rate_dps = 360.0 + 240.0 * sin(g_now_s * 0.7);
+    double angle = rate_dps * g_now_s * M_PI / 180.0;
+
+    gyro_data[0] = (float) ((rand() % 200 - 100) / 50.0);
+    gyro_data[1] = (float) ((rand() % 200 - 100) / 50.0);
+    gyro_data[2] = (float) rate_dps;
+    accel_data[0] = (float) cos(angle);
+    accel_data[1] = (float) sin(angle);
+    accel_data[2] = (float) ((rand() % 200 - 100) / 1000.0);
+    wheel_phase_update(gyro_data, accel_data, osKernelGetSysTimerCount());
+
+    uint16_t accel_sum = 0;
+    uint16_t gyro_sum = 0;
+    for (int i = 0; i < 3; i++) {
+        smooth_accel_data[i] = (smooth_accel_data[i] * FILTER_SMOOTHING_FACTOR + accel_data[i]) / (FILTER_SMOOTHING_FACTOR + 1);
+        smooth_gyro_data[i] = (smooth_gyro_data[i] * FILTER_SMOOTHING_FACTOR + gyro_data[i]) / (FILTER_SMOOTHING_FACTOR + 1);
+        mapped_accel_data[i] = map_value(smooth_accel_data[i], ACCEL_MAP_IN_MIN, ACCEL_MAP_IN_MAX, ACCEL_MAP_OUT_MIN, ACCEL_MAP_OUT_MAX, MAPPING_MODE);
+        mapped_gyro_data[i] = map_value(smooth_gyro_data[i], GYRO_MAP_IN_MIN, GYRO_MAP_IN_MAX, GYRO_MAP_OUT_MAX, GYRO_MAP_OUT_MIN, MAPPING_MODE);
+        accel_sum += mapped_accel_data[i];
+        gyro_sum += mapped_gyro_data[i];
+    }
+    magnitude_mapped_accel_data = (uint8_t) std::clamp(accel_sum / 3, 0, 255);
+    magnitude_mapped_gyro_data = (uint8_t) std::clamp(gyro_sum / 3, 0, 255);
+}
+
+
+static void counting_encode_pixel(uint8_t *out, uint8_t red, uint8_t green, uint8_t blue) {
+    g_encoded_bytes += led_protocol_ws2812b.bytes_per_pixel;
+    led_protocol_ws2812b.encode_pixel(out, red, green, blue);
+}
+
+static void counting_encode_group(uint8_t *out, const uint8_t (*pixels)[3]) {
+    g_encoded_bytes += LED_PROTOCOL_GROUP_PIXELS * led_protocol_ws2812b.bytes_per_pixel;
+    led_protocol_ws2812b.encode_group(out, pixels);
+}
+
+
+/* Runs frames of the current filter slot by slot, returns the number of slots. */
+static long run_frames(int frames) {
+    long slots = 0;
+
+    for (int frame = 0; frame < frames; frame++) {
+        sample_sensors();
+        call_current_led_filter(led_strip_frame());
+        int subframes = current_led_filter_subframes();
+        subframes = subframes > 0 ? subframes : LED_STRIP_DITHER_SUBFRAMES;
+        led_strip_submit_frame();
+        update_leds();
+        slots++;
+
+        for (int slot = 1; slot < subframes; slot++) {
+            g_now_s += 1.0 / (FRAME_RATE_FPS * subframes);
+            if (call_current_led_filter_subframe(led_strip_frame())) {
+                led_strip_submit_frame();
+            } else {
+                led_strip_dither();
+            }
+            update_leds();
+            slots++;
+        }
+        g_now_s += 1.0 / (FRAME_RATE_FPS * subframes);
+    }
+    return slots;
+}
+
+
+int main() {
+    g_counting_ws2812b = led_protocol_ws2812b;
+    g_counting_ws2812b.encode_pixel = counting_encode_pixel;
+    g_counting_ws2812b.encode_group = counting_encode_group;
+
+    CHECK(led_strip_init(NUM_PIXELS) == 0, "led_strip_init() failed");
+    srand(1);
+
+    const struct led_protocol *protocol = &g_counting_ws2812b;
+    long buffer_bytes = protocol->header_bytes + (long) protocol->bytes_per_pixel * NUM_PIXELS + protocol->trailer_bytes(NUM_PIXELS);
+
+    printf("%-12s %24s %24s\n", "filter", "encoded of full refresh", "sent of full refresh");
+    for (int mode = 0; mode < MODE_MAX_VALUE; mode++) {
+        current_state = (AppState) mode;
+        run_frames(FILTER_TRANSITION_FRAMES + 1);
+
+        led_strip_reset_stats();
+        uint64_t encoded_before = g_encoded_bytes;
+        uint64_t sent_before = host_spi_bytes;
+        long slots = run_frames(BENCH_SECONDS * FRAME_RATE_FPS);
+
+        struct led_strip_stats stats;
+        led_strip_get_stats(&stats);
+        double encoded = (double) (g_encoded_bytes - encoded_before);
+        double sent = (double) (host_spi_bytes - sent_before);
+        double full_encoded = (double) slots * NUM_PIXELS * protocol->bytes_per_pixel;
+        double full_sent = (double) slots * buffer_bytes;
+
+        printf("%-12s %10.0f/%-9.0f %4.1f%% %10.0f/%-9.0f %4.1f%%\n", led_filter_name((AppState) mode),
+               encoded, full_encoded, 100.0 * encoded / full_encoded, sent, full_sent, 100.0 * sent / full_sent);
+        CHECK(encoded <= full_encoded && sent <= full_sent, "%s does more work than a full refresh", led_filter_name((AppState) mode));
+        CHECK(stats.transfers > 0, "%s sent nothing", led_filter_name((AppState) mode));
+    }
+    return host_test_result();
+}
@@ -0,0 +1,82 @@
+/*
+ * File: bench_encoding.cpp
+ * Description: Cost of the WS2812B bit encodings of ws2812b/ws2812b_encoding.h.
+ *
+ * Encodes a 50 pixel strip many times with every encoding and with the three
+ * hand-written tables the driver used before, which split each colour byte into bit
+ * fields. The encodings have to agree with each other before they are timed: the
+ * 3 bit ones byte for byte, the 4 bit one after decoding.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "ws2812b/ws2812b_encoding.h"
+#include "ws2812b/one_wire_decoder.h"
+#include "host_test.h"
+#include "bench.h"
+
+#define BENCH_CHANNELS (3 * 50)
+#define BENCH_FRAMES (2000)
+
+
+/* The encoder the driver had before the encodings were generated. */
+struct HandWrittenEncoder : Ws2812bSymbols3Bit {
+    static inline void encode_channels(uint8_t *out, const uint8_t *channels, int count) {
+        for (int i = 0; i < count; i++) {
+            out[0] = most_significant_byte[channels[i] >> 5];
+            out[1] = med_significant_byte[(channels[i] >> 3) & 0x03];
+            out[2] = least_significant_byte[channels[i] & 0x07];
+            out += 3;
+        }
+    }
+};
+
+
+template<typename Encoder>
+static double bench_encoder(const char *name, const std::vector<uint8_t> &channels) {
+    std::vector<uint8_t> out(Encoder::BYTES_PER_CHANNEL * channels.size());
+    double ns = bench_ns_per_item((long) BENCH_FRAMES * (long) channels.size(), [&] {
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            Encoder::encode_channels(out.data(), channels.data(), (int) channels.size());
+            bench_keep(out[0]);
+        }
+    });
+    printf("%-12s %6.2f ns/byte %7.1f ns per 50 pixels\n", name, ns, ns * BENCH_CHANNELS);
+    return ns;
+}
+
+
+int main() {
+    std::vector<uint8_t> channels(BENCH_CHANNELS);
+    srand(1);
+    for (uint8_t &channel : channels) {
+        channel = (uint8_t) rand();
+    }
+
+    /* All 256 values, then the random frame. */
+    std::vector<uint8_t> values(256);
+    for (int i = 0; i < 256; i++) {
+        values[i] = (uint8_t) i;
+    }
+    for (const std::vector<uint8_t> *input : {&values, &channels}) {
+        int count = (int) input->size();
+        std::vector<uint8_t> hand(3 * count), three(3 * count), word(3 * count), four(4 * count), decoded(count);
+        HandWrittenEncoder::encode_channels(hand.data(), input->data(), count);
+        Ws2812bEncoder3Bit::encode_channels(three.data(), input->data(), count);
+        Ws2812bEncoder3BitWord::encode_channels(word.data(), input->data(), count);
+        Ws2812bEncoder4Bit::encode_channels(four.data(), input->data(), count);
+
+        CHECK(three == hand, "3BIT differs from the hand-written tables");
+        CHECK(word == hand, "3BIT_WORD differs from the hand-written tables");
+        int bytes = one_wire_decode(four.data(), (int) four.size(), 3200000, WS2812B_TIMING, decoded.data(), count, NULL);
+        CHECK(bytes == count && decoded == *input, "4BIT does not decode to its input");
+    }
+
+    bench_encoder<HandWrittenEncoder>("hand-written", channels);
+    bench_encoder<Ws2812bEncoder3Bit>("3BIT", channels);
+    bench_encoder<Ws2812bEncoder3BitWord>("3BIT_WORD", channels);
+    bench_encoder<Ws2812bEncoder4Bit>("4BIT", channels);
+    return host_test_result();
+}
@@ -0,0 +1,70 @@
+/*
+ * File: bench_group_encode.cpp
+ * Description: Cost of encoding pixels one by one against groups of
+ * LED_PROTOCOL_GROUP_PIXELS, for every backend of ws2812b/led_protocol.h.
+ *
+ * Both paths have to produce the same bytes before they are timed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "ws2812b/led_protocol.h"
+#include "host_test.h"
+#include "bench.h"
+
+#define BENCH_PIXELS (1024)
+#define BENCH_FRAMES (200)
+
+
+static void encode_pixels(const struct led_protocol *protocol, uint8_t *out, const uint8_t (*pixels)[3]) {
+    for (int i = 0; i < BENCH_PIXELS; i++) {
+        protocol->encode_pixel(out + protocol->bytes_per_pixel * i, pixels[i][0], pixels[i][1], pixels[i][2]);
+    }
+}
+
+static void encode_groups(const struct led_protocol *protocol, uint8_t *out, const uint8_t (*pixels)[3]) {
+    for (int i = 0; i < BENCH_PIXELS; i += LED_PROTOCOL_GROUP_PIXELS) {
+        protocol->encode_group(out + protocol->bytes_per_pixel * i, &pixels[i]);
+    }
+}
+
+
+static void bench_protocol(const struct led_protocol *protocol, const uint8_t (*pixels)[3]) {
+    std::vector<uint8_t> single(protocol->bytes_per_pixel * BENCH_PIXELS);
+    std::vector<uint8_t> grouped(protocol->bytes_per_pixel * BENCH_PIXELS);
+
+    encode_pixels(protocol, single.data(), pixels);
+    encode_groups(protocol, grouped.data(), pixels);
+    CHECK(single == grouped, "%s: encode_group() differs from encode_pixel()", protocol->name);
+
+    double pixel_ns = bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            encode_pixels(protocol, single.data(), pixels);
+            bench_keep(single[0]);
+        }
+    });
+    double group_ns = bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            encode_groups(protocol, grouped.data(), pixels);
+            bench_keep(grouped[0]);
+        }
+    });
+    printf("%-12s per pixel %5.2f ns/pixel, grouped %5.2f ns/pixel\n", protocol->name, pixel_ns, group_ns);
+}
+
+
+int main() {
+    static uint8_t pixels[BENCH_PIXELS][3];
+    srand(1);
+    for (int i = 0; i < BENCH_PIXELS; i++) {
+        for (int c = 0; c < 3; c++) {
+            pixels[i][c] = (uint8_t) rand();
+        }
+    }
+
+    bench_protocol(&led_protocol_ws2812b, pixels);
+    bench_protocol(&led_protocol_sk6812_rgbw, pixels);
+    bench_protocol(&led_protocol_apa102, pixels);
+    return host_test_result();
+}
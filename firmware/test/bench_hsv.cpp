@@ -0,0 +1,134 @@
+/*
+ * File: bench_hsv.cpp
+ * Description: Accuracy and cost of utils/hsv_to_rgb.h against the float HSV formula
+ * the star filter used before.
+ *
+ * Every one of the 16.7M inputs has to stay within 1 of the float formula on every
+ * channel. hsv_to_rgb_n() has to write the same frame as hsv_to_rgb() per pixel. The
+ * timing converts 4096 pixels, a quarter of them dark, which are skipped as the filters
+ * skip them.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/hsv_to_rgb.h"
+#include "host_test.h"
+#include "bench.h"
+
+#define BENCH_PIXELS (4096)
+#define BENCH_FRAMES (200)
+
+
+/* The float converter hsv_to_rgb.cpp replaced. */
+static void float_hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b) {
+    float hue = h / 255.0f;
+    float saturation = s / 255.0f;
+    float value = v / 255.0f;
+    float c = value * saturation;
+    float x = c * (1.0f - fabsf(fmodf(hue * 6.0f, 2.0f) - 1.0f));
+    float m = value - c;
+    float r1, g1, b1;
+
+    if (hue < 1.0f / 6.0f) {
+        r1 = c; g1 = x; b1 = 0;
+    } else if (hue < 2.0f / 6.0f) {
+        r1 = x; g1 = c; b1 = 0;
+    } else if (hue < 3.0f / 6.0f) {
+        r1 = 0; g1 = c; b1 = x;
+    } else if (hue < 4.0f / 6.0f) {
+        r1 = 0; g1 = x; b1 = c;
+    } else if (hue < 5.0f / 6.0f) {
+        r1 = x; g1 = 0; b1 = c;
+    } else {
+        r1 = c; g1 = 0; b1 = x;
+    }
+    r = (uint8_t) ((r1 + m) * 255.0f);
+    g = (uint8_t) ((g1 + m) * 255.0f);
+    b = (uint8_t) ((b1 + m) * 255.0f);
+}
+
+
+static void test_accuracy() {
+    int max_error = 0;
+    long error_sum = 0;
+
+    for (int h = 0; h < 256; h++) {
+        for (int s = 0; s < 256; s++) {
+            for (int v = 0; v < 256; v++) {
+                uint8_t fixed[3], reference[3];
+                hsv_to_rgb(h, s, v, fixed[0], fixed[1], fixed[2]);
+                float_hsv_to_rgb(h, s, v, reference[0], reference[1], reference[2]);
+                for (int c = 0; c < 3; c++) {
+                    int error = abs(fixed[c] - reference[c]);
+                    max_error = std::max(max_error, error);
+                    error_sum += error;
+                }
+            }
+        }
+    }
+    printf("error against the float formula: max %d, mean %.3f\n", max_error, error_sum / (3.0 * (1 << 24)));
+    CHECK(max_error <= 1, "max error %d", max_error);
+}
+
+
+static void test_batch(const uint8_t (*hsv)[3], FrameBuffer *frame) {
+    static uint8_t expected_pixels[3 * BENCH_PIXELS];
+    FrameBuffer expected = {frame->format, frame->bytes_per_pixel, frame->num_pixels, expected_pixels};
+
+    for (int i = 0; i < BENCH_PIXELS; i++) {
+        uint8_t r, g, b;
+        hsv_to_rgb(hsv[i][0], hsv[i][1], hsv[i][2], r, g, b);
+        frame_buffer_set_rgb(&expected, i, r, g, b);
+    }
+    memset(frame->pixels, 0x55, 3 * BENCH_PIXELS);
+    hsv_to_rgb_n(hsv, frame, BENCH_PIXELS);
+    CHECK(memcmp(frame->pixels, expected_pixels, 3 * BENCH_PIXELS) == 0, "hsv_to_rgb_n() differs from hsv_to_rgb()");
+}
+
+
+template<typename Convert>
+static double bench_converter(const uint8_t (*hsv)[3], FrameBuffer *frame, Convert convert) {
+    return bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+        for (int run = 0; run < BENCH_FRAMES; run++) {
+            for (int i = 0; i < BENCH_PIXELS; i++) {
+                if (hsv[i][2] == 0) {
+                    frame_buffer_set_rgb(frame, i, 0, 0, 0);
+                    continue;
+                }
+                uint8_t r, g, b;
+                convert(hsv[i][0], hsv[i][1], hsv[i][2], r, g, b);
+                frame_buffer_set_rgb(frame, i, r, g, b);
+            }
+            bench_keep(frame->pixels[0]);
+        }
+    });
+}
+
+
+int main() {
+    test_accuracy();
+
+    static uint8_t hsv[BENCH_PIXELS][3];
+    static uint8_t pixels[3 * BENCH_PIXELS];
+    FrameBuffer frame = {PIXEL_FORMAT_GRB888, 3, BENCH_PIXELS, pixels};
+    for (int i = 0; i < BENCH_PIXELS; i++) {
+        hsv[i][0] = (uint8_t) (i * 7);
+        hsv[i][1] = (uint8_t) (i * 13);
+        hsv[i][2] = i % 4 ? (uint8_t) (i * 3) : 0;
+    }
+
+    test_batch(hsv, &frame);
+
+    double fixed_ns = bench_converter(hsv, &frame, hsv_to_rgb);
+    double float_ns = bench_converter(hsv, &frame, float_hsv_to_rgb);
+    double batch_ns = bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+        for (int run = 0; run < BENCH_FRAMES; run++) {
+            hsv_to_rgb_n(hsv, &frame, BENCH_PIXELS);
+            bench_keep(frame.pixels[0]);
+        }
+    });
+    printf("hsv_to_rgb %.2f ns/pixel, hsv_to_rgb_n %.2f ns/pixel, float %.2f ns/pixel\n", fixed_ns, batch_ns, float_ns);
+    return host_test_result();
+}
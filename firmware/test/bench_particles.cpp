@@ -0,0 +1,119 @@
+/*
+ * File: bench_particles.cpp
+ * Description: Rendering, wrap-around and pool accounting of particles/particles.h,
+ * and the cost of a full pool.
+ *
+ * A red particle at full life a quarter past pixel 10 lights pixel 10 at 191 and
+ * pixel 11 at 63, or only pixel 10 without anti-aliasing. Particles that run off
+ * either end of the strip come back at the other, and a spawn on a full pool is
+ * refused and counted. The timing updates and renders a full pool of
+ * PARTICLE_POOL_CAPACITY particles on NUM_PIXELS pixels per frame.
+ */
+
+#include <stdio.h>
+#include "particles/particles.h"
+#include "host_test.h"
+#include "bench.h"
+
+#define BENCH_FRAMES (2000)
+
+
+static struct particle *spawn_at(struct particle_pool *pool, double position, double velocity) {
+    struct particle *p = particle_spawn(pool);
+    p->position = PARTICLE_PIXELS(position);
+    p->velocity = PARTICLE_PIXELS(velocity);
+    p->life = PARTICLE_LIFE_FULL;
+    p->decay = 0;
+    p->hue = 0;
+    return p;
+}
+
+
+static void test_render(FrameBuffer *frame) {
+    static struct particle_pool pool;
+    particle_pool_init(&pool);
+    spawn_at(&pool, 10.25, 0);
+
+    uint8_t r, g, b;
+    particle_pool_render(&pool, frame, true);
+    frame_buffer_get_rgb(frame, 10, &r, &g, &b);
+    CHECK(r == 191 && g == 0 && b == 0, "pixel 10 is %d %d %d, expected 191 0 0", r, g, b);
+    frame_buffer_get_rgb(frame, 11, &r, &g, &b);
+    CHECK(r == 63 && g == 0 && b == 0, "pixel 11 is %d %d %d, expected 63 0 0", r, g, b);
+    frame_buffer_get_rgb(frame, 9, &r, &g, &b);
+    CHECK(r == 0, "pixel 9 is lit at %d", r);
+
+    particle_pool_render(&pool, frame, false);
+    frame_buffer_get_rgb(frame, 10, &r, &g, &b);
+    CHECK(r == 255, "pixel 10 is %d without anti-aliasing, expected 255", r);
+    frame_buffer_get_rgb(frame, 11, &r, &g, &b);
+    CHECK(r == 0, "pixel 11 is lit at %d without anti-aliasing", r);
+
+    /* Between the last and the first pixel both are lit. */
+    particle_pool_init(&pool);
+    spawn_at(&pool, NUM_PIXELS - 0.5, 0);
+    particle_pool_render(&pool, frame, true);
+    uint8_t last, first;
+    frame_buffer_get_rgb(frame, NUM_PIXELS - 1, &last, &g, &b);
+    frame_buffer_get_rgb(frame, 0, &first, &g, &b);
+    CHECK(last == 127 && first == 127, "last and first pixel are %d and %d, expected 127", last, first);
+}
+
+
+static void test_wrap() {
+    static struct particle_pool pool;
+    particle_pool_init(&pool);
+    struct particle *forward = spawn_at(&pool, NUM_PIXELS - 1, 1.5);
+    struct particle *backward = spawn_at(&pool, 0.5, -1);
+
+    particle_pool_update(&pool, NUM_PIXELS);
+    CHECK(forward->position == PARTICLE_PIXELS(0.5), "forward particle at %d/65536, expected 0.5", forward->position);
+    CHECK(backward->position == PARTICLE_PIXELS(NUM_PIXELS - 0.5), "backward particle at %d/65536, expected %d.5",
+          backward->position, NUM_PIXELS - 1);
+}
+
+
+static void test_pool() {
+    static struct particle_pool pool;
+    particle_pool_init(&pool);
+    for (int i = 0; i < PARTICLE_POOL_CAPACITY; i++) {
+        spawn_at(&pool, i % NUM_PIXELS, 0)->decay = (uint16_t) (i < 10 ? PARTICLE_LIFE_FULL : 1);
+    }
+    CHECK(particle_spawn(&pool) == NULL && particle_spawn(&pool) == NULL, "spawned on a full pool");
+    CHECK(pool.dropped == 2, "dropped %lu spawns, expected 2", (unsigned long) pool.dropped);
+
+    /* The ten particles that run out are freed, the others stay packed at the front. */
+    particle_pool_update(&pool, NUM_PIXELS);
+    CHECK(pool.count == PARTICLE_POOL_CAPACITY - 10, "%d particles left, expected %d", pool.count, PARTICLE_POOL_CAPACITY - 10);
+    for (int i = 0; i < pool.count; i++) {
+        CHECK(pool.particles[i].decay == 1, "freed particle at %d", i);
+    }
+    CHECK(particle_spawn(&pool) != NULL && pool.dropped == 2, "no spawn after particles were freed");
+}
+
+
+int main() {
+    static uint8_t pixels[3 * NUM_PIXELS];
+    FrameBuffer frame = {PIXEL_FORMAT_GRB888, 3, NUM_PIXELS, pixels};
+
+    test_render(&frame);
+    test_wrap();
+    test_pool();
+
+    /* A full pool that lives for the whole run. */
+    static struct particle_pool pool;
+    particle_pool_init(&pool);
+    for (int i = 0; i < PARTICLE_POOL_CAPACITY; i++) {
+        struct particle *p = spawn_at(&pool, (i * 7) % NUM_PIXELS + i / 256.0, (i % 9 - 4) / 8.0);
+        p->hue = (uint8_t) (i * 37);
+    }
+    double ns = bench_ns_per_item(BENCH_FRAMES, [&] {
+        for (int run = 0; run < BENCH_FRAMES; run++) {
+            particle_pool_update(&pool, NUM_PIXELS);
+            particle_pool_render(&pool, &frame, true);
+            bench_keep(frame.pixels[0]);
+        }
+    });
+    printf("%d particles on %d pixels: %.2f us per frame\n", PARTICLE_POOL_CAPACITY, NUM_PIXELS, ns / 1000.0);
+    return host_test_result();
+}
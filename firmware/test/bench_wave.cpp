@@ -0,0 +1,98 @@
+/*
+ * File: bench_wave.cpp
+ * Description: LEDFilter_Wave on the Q15 sine table against the sinf() version it
+ * replaced.
+ *
+ * Both filters run 200 frames on 1024 pixels from the same sensor data. The input
+ * keeps the gain between 0 and 255/base, where the float version's casts do not wrap,
+ * and there the outputs have to stay within 1 of each other.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "led_filters/LEDFilter_Wave.h"
+#include "host_test.h"
+#include "bench.h"
+
+#define BENCH_PIXELS (1024)
+#define BENCH_FRAMES (200)
+
+/* Sensor data, defined in main.cpp on the target. */
+uint8_t mapped_accel_data[3] = {90, 40, 110};
+uint8_t mapped_gyro_data[3] = {30, 90, 10};
+
+
+/* The wave filter before the sine table, with the float wave position and sinf(). */
+class FloatWave : public LEDFilter {
+public:
+    void apply_filter(FrameBuffer *frame) {
+        for (int i = 0; i < 3; i++) {
+            smooth_values_accel[i] = (smooth_values_accel[i] * smoothing_factor + p_mapped_accel_data[i]) / (smoothing_factor + 1);
+            smooth_values_gyro[i] = (smooth_values_gyro[i] * smoothing_factor + p_mapped_gyro_data[i]) / (smoothing_factor + 1);
+        }
+
+        float wave_frequency = (smooth_values_gyro[0] + smooth_values_gyro[1] + smooth_values_gyro[2]) / 3.0f * wave_frequency_factor;
+        float wave_amplitude = (smooth_values_accel[0] + smooth_values_accel[1] + smooth_values_accel[2]) / 3.0f * wave_amplitude_factor;
+
+        wave_position += wave_frequency;
+        if (wave_position > 2 * M_PI) wave_position -= 2 * M_PI;
+
+        for (int i = 0; i < frame->num_pixels; i++) {
+            float wave_value = sinf(wave_position + (2 * M_PI * i / frame->num_pixels)) * wave_amplitude;
+            uint8_t base_color[3] = {smooth_values_accel[0], smooth_values_accel[1], smooth_values_accel[2]};
+            frame_buffer_set_rgb(frame, i,
+                                 static_cast<uint8_t>(base_color[0] * (1 + wave_value)),
+                                 static_cast<uint8_t>(base_color[1] * (1 + wave_value)),
+                                 static_cast<uint8_t>(base_color[2] * (1 + wave_value)));
+        }
+    }
+
+private:
+    float smoothing_factor = FILTER_WAVE_SMOOTHING;
+    float wave_frequency_factor = FILTER_WAVE_FREQUENCY;
+    float wave_amplitude_factor = FILTER_WAVE_AMPLITUDE;
+    uint8_t smooth_values_accel[3] = {0};
+    uint8_t smooth_values_gyro[3] = {0};
+    float wave_position = 0;
+};
+
+
+template<typename Filter>
+static double bench_filter(Filter &filter, FrameBuffer *frame) {
+    return bench_ns_per_item((long) BENCH_FRAMES * BENCH_PIXELS, [&] {
+        for (int run = 0; run < BENCH_FRAMES; run++) {
+            filter.apply_filter(frame);
+            bench_keep(frame->pixels[0]);
+        }
+    });
+}
+
+
+int main() {
+    static uint8_t table_pixels[3 * BENCH_PIXELS];
+    static uint8_t float_pixels[3 * BENCH_PIXELS];
+    FrameBuffer table_frame = {PIXEL_FORMAT_GRB888, 3, BENCH_PIXELS, table_pixels};
+    FrameBuffer float_frame = {PIXEL_FORMAT_GRB888, 3, BENCH_PIXELS, float_pixels};
+    LEDFilter_Wave table_wave;
+    FloatWave float_wave;
+    int max_diff = 0;
+    long diff_sum = 0;
+
+    for (int run = 0; run < BENCH_FRAMES; run++) {
+        table_wave.apply_filter(&table_frame);
+        float_wave.apply_filter(&float_frame);
+        for (int i = 0; i < 3 * BENCH_PIXELS; i++) {
+            int diff = abs(table_pixels[i] - float_pixels[i]);
+            max_diff = std::max(max_diff, diff);
+            diff_sum += diff;
+        }
+    }
+    printf("difference to sinf(): max %d, mean %.3f\n", max_diff, diff_sum / (3.0 * BENCH_PIXELS * BENCH_FRAMES));
+    CHECK(max_diff <= 1, "max difference %d", max_diff);
+
+    double table_ns = bench_filter(table_wave, &table_frame);
+    double float_ns = bench_filter(float_wave, &float_frame);
+    printf("sine table %.2f ns/pixel, sinf() %.2f ns/pixel\n", table_ns, float_ns);
+    return host_test_result();
+}
@@ -0,0 +1,43 @@
+/*
+ * File: blend_reference.h
+ * Description: Byte by byte versions of the blend modes of utils/blend_simd.h, which
+ * the word kernels have to match bit for bit.
+ */
+#pragma once
+#include <stdint.h>
+#include "utils/blend_simd.h"
+
+static inline uint8_t reference_lerp(uint32_t dst, uint32_t src, uint32_t weight) {
+    return (uint8_t) ((dst * (256U - weight) + src * weight) >> 8);
+}
+
+static inline uint8_t reference_multiply(uint32_t a, uint32_t b) {
+    uint32_t product = a * b + 128U;
+    return (uint8_t) (((product >> 8) + product) >> 8);
+}
+
+static inline uint8_t reference_blend(uint8_t dst, uint8_t src, BlendMode mode, uint32_t weight) {
+    switch (mode) {
+        case BLEND_MODE_ADD: {
+            uint32_t sum = dst + ((src * weight) >> 8);
+            return (uint8_t) (sum > 255U ? 255U : sum);
+        }
+        case BLEND_MODE_MULTIPLY:
+            return reference_lerp(dst, reference_multiply(dst, src), weight);
+        case BLEND_MODE_SCREEN:
+            return reference_lerp(dst, 255U - reference_multiply(255U - dst, 255U - src), weight);
+        default:
+            return reference_lerp(dst, src, weight);
+    }
+}
+
+/* Number of bytes of the words in which blend_word() differs from the reference. */
+static inline int reference_check_word(uint32_t dst, uint32_t src, BlendMode mode, uint32_t weight) {
+    uint32_t out = blend_word(dst, src, mode, weight);
+    int mismatches = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint8_t expected = reference_blend((uint8_t) (dst >> shift), (uint8_t) (src >> shift), mode, weight);
+        mismatches += (uint8_t) (out >> shift) != expected;
+    }
+    return mismatches;
+}
@@ -0,0 +1,10 @@
+/*
+ * File: host_cdefs.h
+ * Description: Compiler macros that the ColdwaveOS headers take from the newlib of
+ * the ARM toolchain. Force-included into host builds that include driver.h.
+ */
+#pragma once
+
+#ifndef __section
+#define __section(x) __attribute__((section(x)))
+#endif
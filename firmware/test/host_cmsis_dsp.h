@@ -0,0 +1,44 @@
+/*
+ * File: host_cmsis_dsp.h
+ * Description: Plain C versions of the Cortex-M33 DSP intrinsics of cmsis_gcc.h
+ * that utils/blend_simd.h uses, so its BLEND_SIMD_DSP path runs on the host.
+ *
+ * Include it and define BLEND_SIMD_DSP before blend_simd.h. Only define names that
+ * cmsis_gcc.h has, otherwise the host test passes while the target build fails.
+ */
+#pragma once
+#include <stdint.h>
+
+static inline uint32_t __ROR(uint32_t value, uint32_t shift) {
+    shift &= 31;
+    return shift == 0 ? value : (value >> shift) | (value << (32 - shift));
+}
+
+static inline uint32_t __UXTB16(uint32_t value) {
+    return value & 0x00FF00FFU;
+}
+
+static inline uint32_t __PKHBT(uint32_t bottom, uint32_t top, uint32_t shift) {
+    return (bottom & 0x0000FFFFU) | ((top << shift) & 0xFFFF0000U);
+}
+
+static inline uint32_t __PKHTB(uint32_t top, uint32_t bottom, uint32_t shift) {
+    return (top & 0xFFFF0000U) | ((uint32_t) ((int32_t) bottom >> shift) & 0x0000FFFFU);
+}
+
+static inline uint32_t __SMUAD(uint32_t a, uint32_t b) {
+    return (uint32_t) ((int32_t) (int16_t) a * (int16_t) b + (int32_t) (int16_t) (a >> 16) * (int16_t) (b >> 16));
+}
+
+static inline uint32_t __SMLAD(uint32_t a, uint32_t b, uint32_t accumulator) {
+    return __SMUAD(a, b) + accumulator;
+}
+
+static inline uint32_t __UQADD8(uint32_t a, uint32_t b) {
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t sum = ((a >> shift) & 0xFFU) + ((b >> shift) & 0xFFU);
+        out |= (sum > 0xFFU ? 0xFFU : sum) << shift;
+    }
+    return out;
+}
@@ -0,0 +1,120 @@
+/*
+ * File: host_drivers.cpp
+ * Description: ColdwaveOS drivers and kernel objects for host builds of the LED
+ * strip driver, single threaded.
+ *
+ * SPI devices count the bytes written to them and drop them. "tim0" is a latch
+ * timer that elapses right away. GPIOs accept everything. The kernel objects only
+ * cover one strip, which the driver runs without output threads, so osThreadNew()
+ * fails. The kernel clock is left to the program, which simulates the time.
+ */
+
+#include <string.h>
+#include "driver.h"
+#include "spi.h"
+/* timer.h reuses the include guard of spi.h */
+#undef _COLDWAVEOS_SPI_H
+#include "timer.h"
+#include "gpio.h"
+#include "kernel.h"
+#include "host_drivers.h"
+
+#define HOST_DEVICES (4)
+
+uint64_t host_spi_bytes = 0;
+uint32_t host_spi_transfers = 0;
+
+static struct device g_devices[HOST_DEVICES];
+static int g_device_count = 0;
+static struct spi_driver g_spi_driver;
+static struct timer_driver g_timer_driver;
+static uint32_t g_semaphore_tokens;
+
+
+static int host_spi_transfer(struct device *dev, const uint8_t *data_out, uint8_t *data_in, size_t len) {
+    host_spi_bytes += len;
+    host_spi_transfers++;
+    return 0;
+}
+
+static int host_timer_start(struct device *dev, const uint8_t type, const uint32_t freq, timer_callback_f callback) {
+    callback(0);
+    return 0;
+}
+
+
+int open(const char *device_name) {
+    if (g_device_count == HOST_DEVICES) {
+        return -1;
+    }
+
+    struct device *dev = &g_devices[g_device_count];
+    memset(dev, 0, sizeof(*dev));
+    strncpy(dev->name, device_name, sizeof(dev->name) - 1);
+    if (strncmp(device_name, "spi", 3) == 0) {
+        g_spi_driver.spi_transfer = host_spi_transfer;
+        dev->drv = &g_spi_driver.drv;
+    } else if (strcmp(device_name, "tim0") == 0) {
+        g_timer_driver.timer_start = host_timer_start;
+        dev->drv = &g_timer_driver.drv;
+    } else {
+        return -1;
+    }
+    return g_device_count++;
+}
+
+struct device *device_for_handle(int hDev) {
+    return hDev >= 0 && hDev < g_device_count ? &g_devices[hDev] : NULL;
+}
+
+cw_driver_return_t gpio_set(uint16_t pin, gpio_pin_state_t state) {
+    return 0;
+}
+
+cw_driver_return_t gpio_set_dir(uint16_t gpio, gpio_pin_dir_t dir) {
+    return 0;
+}
+
+
+/* One semaphore, the latch token of the driver. */
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr) {
+    g_semaphore_tokens = initial_count;
+    return &g_semaphore_tokens;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout) {
+    if (g_semaphore_tokens == 0) {
+        return osErrorResource;
+    }
+    g_semaphore_tokens--;
+    return osOK;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id) {
+    g_semaphore_tokens++;
+    return osOK;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+    return NULL;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+    return osFlagsErrorParameter;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    return osFlagsErrorResource;
+}
+
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr) {
+    return NULL;
+}
+
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags) {
+    return osFlagsErrorParameter;
+}
+
+uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout) {
+    return osFlagsErrorResource;
+}
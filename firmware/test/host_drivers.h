@@ -0,0 +1,10 @@
+/*
+ * File: host_drivers.h
+ * Description: ColdwaveOS drivers and kernel objects for host builds of the LED
+ * strip driver, ws2812b/ws2812b.cpp, see host_drivers.cpp.
+ */
+#pragma once
+#include <stdint.h>
+
+extern uint64_t host_spi_bytes;        // bytes written to all SPI devices
+extern uint32_t host_spi_transfers;    // SPI writes to all devices
@@ -0,0 +1,32 @@
+/*
+ * File: host_logging.cpp
+ * Description: ColdwaveOS log output for the host builds, printed to stdout.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include "logging.h"
+
+
+void cw_log_output(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+void cw_log_prepare_formatting(int lvl) {
+}
+
+void cw_log_prefix(int lvl, const char *mod) {
+    printf("[%s] ", mod);
+}
+
+void cw_log_cleanup(int nl) {
+    if (nl) {
+        printf("\n");
+    }
+}
+
+void cw_log_timestamp(void) {
+}
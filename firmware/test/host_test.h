@@ -0,0 +1,29 @@
+/*
+ * File: host_test.h
+ * Description: Minimal checks for the host tests, see CMakeLists.txt.
+ *
+ * A failed CHECK prints where it failed and counts the failure. A test returns
+ * host_test_result() from main(), so ctest sees every failure of a run at once.
+ */
+#pragma once
+#include <stdio.h>
+
+static int host_test_failures = 0;
+
+#define CHECK(condition, ...) do { \
+        if (!(condition)) { \
+            printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #condition); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            host_test_failures++; \
+        } \
+    } while (0)
+
+static inline int host_test_result() {
+    if (host_test_failures > 0) {
+        printf("%d checks failed\n", host_test_failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
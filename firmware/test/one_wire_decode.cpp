@@ -0,0 +1,101 @@
+/*
+ * File: one_wire_decode.cpp
+ * Description: Decodes an SPI dump of a one-wire strip into pixels and checks its timing.
+ *
+ * usage: one_wire_decode [-c ws2812b|sk6812] [-b baudrate] dump.bin
+ *
+ * The dump holds the bytes on MOSI as captured, MSB first, e.g. exported from a logic
+ * analyser. The baudrate defaults to the one globals.h configures for the chip. Every
+ * pixel is printed as red, green, blue (and white), followed by the pulse widths the
+ * decoder measured. The exit code is 1 if the stream violates the datasheet timing or
+ * ends in the middle of a byte.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include "ws2812b/one_wire_decoder.h"
+#include "globals.h"
+
+
+static int usage() {
+    fprintf(stderr, "usage: one_wire_decode [-c ws2812b|sk6812] [-b baudrate] dump.bin\n");
+    return 2;
+}
+
+
+int main(int argc, char **argv) {
+    const OneWireTiming *timing = &WS2812B_TIMING;
+    uint32_t baudrate = 0;
+    int channels = 3;
+    int option;
+
+    while ((option = getopt(argc, argv, "c:b:")) != -1) {
+        if (option == 'c' && strcmp(optarg, "ws2812b") == 0) {
+            timing = &WS2812B_TIMING;
+            channels = 3;
+        } else if (option == 'c' && strcmp(optarg, "sk6812") == 0) {
+            timing = &SK6812_TIMING;
+            channels = 4;
+        } else if (option == 'b') {
+            baudrate = (uint32_t) strtoul(optarg, NULL, 0);
+        } else {
+            return usage();
+        }
+    }
+    if (optind != argc - 1) {
+        return usage();
+    }
+    if (baudrate == 0) {
+        baudrate = channels == 4 ? SK6812_SPI_BAUDRATE : SPI_BAUDRATE;
+    }
+
+    FILE *file = fopen(argv[optind], "rb");
+    if (file == NULL) {
+        perror(argv[optind]);
+        return 2;
+    }
+    std::vector<uint8_t> stream;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        stream.insert(stream.end(), chunk, chunk + read);
+    }
+    fclose(file);
+
+    /* Every data bit takes at least one SPI bit. */
+    std::vector<uint8_t> wire(stream.size() + 1);
+    OneWireDecodeReport report;
+    int bytes = one_wire_decode(stream.data(), (int) stream.size(), baudrate, *timing,
+                                wire.data(), (int) wire.size(), &report);
+
+    for (int i = 0; i + channels <= (bytes < 0 ? report.bits / 8 : bytes); i += channels) {
+        /* Wire order is green, red, blue, white */
+        printf("pixel %d: %u %u %u", i / channels, wire[i + 1], wire[i], wire[i + 2]);
+        if (channels == 4) {
+            printf(" %u", wire[i + 3]);
+        }
+        printf("\n");
+    }
+
+    printf("%d bits at %u baud, %d timing violations", report.bits, (unsigned) baudrate, report.timing_violations);
+    if (report.timing_violations > 0) {
+        printf(", the first at bit %d", report.first_violation_bit);
+    }
+    printf("\n");
+    for (int value = 0; value < 2; value++) {
+        if (report.high_ns_max[value] > 0) {
+            printf("T%dH %u..%u ns\n", value, (unsigned) report.high_ns_min[value], (unsigned) report.high_ns_max[value]);
+        }
+    }
+    if (bytes < 0) {
+        printf("the stream ends after %d bits, in the middle of a byte\n", report.bits);
+    }
+    if (bytes > 0 && bytes % channels != 0) {
+        printf("%d bytes left over after the last pixel\n", bytes % channels);
+    }
+
+    return bytes < 0 || report.timing_violations > 0 ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * File: png_writer.h
+ * Description: Writes 8 bit RGB images as PNG for the host tools, without zlib.
+ *
+ * The image data goes into stored (uncompressed) deflate blocks, so the files are
+ * as large as the pixels, which is fine for the few simulator images.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+
+static uint32_t png_crc32(const uint8_t *data, size_t length, uint32_t crc = 0) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void png_put32(std::vector<uint8_t> *out, uint32_t value) {
+    out->insert(out->end(), {(uint8_t) (value >> 24), (uint8_t) (value >> 16), (uint8_t) (value >> 8), (uint8_t) value});
+}
+
+static void png_chunk(FILE *file, const char *type, const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> chunk;
+    png_put32(&chunk, (uint32_t) data.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    png_put32(&chunk, png_crc32(chunk.data() + 4, chunk.size() - 4));
+    fwrite(chunk.data(), 1, chunk.size(), file);
+}
+
+
+/**
+ * @brief Writes rows of width RGB pixels, top row first.
+ *
+ * @return 0 on success, -1 if the file cannot be written.
+ */
+static int png_write(const char *path, const uint8_t *rgb, int width, int height) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    /* Every row starts with filter type 0, none. */
+    std::vector<uint8_t> raw;
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb + 3 * width * y, rgb + 3 * width * (y + 1));
+    }
+
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    for (size_t offset = 0; offset < raw.size() || offset == 0; offset += 65535) {
+        uint16_t length = (uint16_t) std::min<size_t>(65535, raw.size() - offset);
+        bool last = offset + length >= raw.size();
+        zlib.insert(zlib.end(), {(uint8_t) last, (uint8_t) length, (uint8_t) (length >> 8),
+                                 (uint8_t) ~length, (uint8_t) (~length >> 8)});
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+    }
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    png_put32(&zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    png_put32(&header, (uint32_t) width);
+    png_put32(&header, (uint32_t) height);
+    header.insert(header.end(), {8, 2, 0, 0, 0}); // 8 bit RGB, deflate, no interlace
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return -1;
+    }
+    fwrite(signature, 1, sizeof(signature), file);
+    png_chunk(file, "IHDR", header);
+    png_chunk(file, "IDAT", zlib);
+    png_chunk(file, "IEND", {});
+    return fclose(file) == 0 ? 0 : -1;
+}
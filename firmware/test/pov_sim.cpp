@@ -0,0 +1,226 @@
+/*
+ * File: pov_sim.cpp
+ * Description: Simulates LEDFilter_POV on a spinning wheel and writes the image a
+ * rider would see as a PNG.
+ *
+ * usage: pov_sim [-r rate_dps] [-b gyro_bias_dps] [-o image.png]
+ *
+ * The wheel starts at rate_dps and speeds up by 30 degrees per second each second.
+ * The ICM is sampled once per frame, with gyro noise and bias, and gravity plus
+ * centripetal acceleration 5 cm off the axle. The filter renders POV_SUBFRAMES columns
+ * per frame on a 1 kHz kernel tick, each column latches after the encode, the SPI
+ * transfer and the reset gap, and is shown until the next one latches.
+ *
+ * Over one revolution 8 s in, every shown column is integrated into the picture at the
+ * angle the wheel really has. The left half of the PNG is the filter, the right half the
+ * same columns rendered for the true angle at the latch. The run fails if the filtered
+ * image strays too far from the ideal one.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <random>
+#include <vector>
+#include "led_filters/LEDFilter_POV.h"
+#include "wheel_phase/wheel_phase.h"
+#include "png_writer.h"
+
+#define SIM_TIMER_HZ (39000000.0)
+#define SIM_IMAGE_SIZE (400)
+#define SIM_WINDOW_S (8.0)
+#define SIM_ENCODE_S (120e-6)            // render to the start of the SPI transfer
+#define SIM_TRANSFER_S (1.44e-3)         // 50 pixels of 9 bytes at 2.5 MHz, plus gaps
+#define SIM_RESET_S (80e-6)
+#define SIM_MAX_MEAN_DIFF (0.45)         // fails the run, columns rendered for the render time instead of the latch give ~0.65
+
+/* Sensor data, defined in main.cpp on the target. */
+float accel_data[3];
+float gyro_data[3];
+
+static double g_now_s = 0;
+static double g_latch_s = 0;
+static double g_rate0_dps = 540;
+
+static uint32_t sys_count(double t) {
+    return (uint32_t) (uint64_t) llround(t * SIM_TIMER_HZ);
+}
+
+uint32_t osKernelGetSysTimerCount(void) {
+    return sys_count(g_now_s);
+}
+
+uint32_t osKernelGetSysTimerFreq(void) {
+    return (uint32_t) SIM_TIMER_HZ;
+}
+
+uint32_t led_strip_latch_time() {
+    return sys_count(g_latch_s);
+}
+
+
+static double wheel_rate_dps(double t) {
+    return g_rate0_dps + 30 * t;
+}
+
+static double wheel_angle_deg(double t) {
+    return 37 + g_rate0_dps * t + 15 * t * t;
+}
+
+
+/* Accumulates the columns the LEDs show over one revolution. */
+struct Exposure {
+    std::vector<double> sum = std::vector<double>(SIM_IMAGE_SIZE * SIM_IMAGE_SIZE * 3, 0);
+    std::vector<double> weight = std::vector<double>(SIM_IMAGE_SIZE * SIM_IMAGE_SIZE, 0);
+
+    /* column was shown from t0 to t1, sampled every 20 us of the revolution window */
+    void add(const uint8_t *column, double t0, double t1) {
+        double end = std::min(t1, SIM_WINDOW_S + 360.0 / wheel_rate_dps(SIM_WINDOW_S));
+        for (double t = std::max(t0, SIM_WINDOW_S); t < end; t += 20e-6) {
+            double wheel = wheel_angle_deg(t) * M_PI / 180;
+            for (int i = 0; i < NUM_PIXELS; i++) {
+                const led_position &position = led_geometry.pixels[i];
+                double angle = wheel + position.angle * 2 * M_PI / LED_ANGLE_TURN;
+                double radius = position.radius / (double) LED_RADIUS_RIM * 0.98;
+                int x = (int) ((radius * sin(angle) * 0.5 + 0.5) * (SIM_IMAGE_SIZE - 1));
+                int y = (int) ((0.5 - radius * cos(angle) * 0.5) * (SIM_IMAGE_SIZE - 1));
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int k = (y + dy) * SIM_IMAGE_SIZE + x + dx;
+                        for (int c = 0; c < 3; c++) {
+                            sum[3 * k + c] += column[3 * i + c];
+                        }
+                        weight[k] += 1;
+                    }
+                }
+            }
+        }
+    }
+
+    uint8_t value(int k, int c) const {
+        return weight[k] > 0 ? (uint8_t) lround(sum[3 * k + c] / weight[k]) : 0;
+    }
+};
+
+
+/* The column LEDFilter_POV renders for a wheel phase, without prediction. */
+static void render_column(uint8_t *column, uint32_t phase) {
+    for (int i = 0; i < NUM_PIXELS; i++) {
+        const led_position &position = led_geometry.pixels[i];
+        uint32_t angle = phase + ((uint32_t) position.angle << 16);
+        const uint8_t *color = pov_image[angle >> (32 - POV_IMAGE_COLUMN_BITS)][(position.radius * POV_IMAGE_ROWS) >> 16];
+        memcpy(&column[3 * i], color, 3);
+    }
+}
+
+
+int main(int argc, char **argv) {
+    const char *path = "pov_sim.png";
+    double gyro_bias_dps = 2.0;
+    int option;
+
+    while ((option = getopt(argc, argv, "r:b:o:")) != -1) {
+        if (option == 'r') {
+            g_rate0_dps = atof(optarg);
+        } else if (option == 'b') {
+            gyro_bias_dps = atof(optarg);
+        } else if (option == 'o') {
+            path = optarg;
+        } else {
+            fprintf(stderr, "usage: pov_sim [-r rate_dps] [-b gyro_bias_dps] [-o image.png]\n");
+            return 2;
+        }
+    }
+
+    std::mt19937 rng(1);
+    std::normal_distribution<double> noise(0, 1);
+    wheel_phase_init();
+    LEDFilter_POV pov;
+
+    uint8_t pixels[NUM_PIXELS * 3];
+    FrameBuffer frame = {PIXEL_FORMAT_RGB888, 3, NUM_PIXELS, pixels};
+    uint8_t shown[NUM_PIXELS * 3] = {0};
+    uint8_t ideal[NUM_PIXELS * 3];
+    uint8_t shown_ideal[NUM_PIXELS * 3] = {0};
+    Exposure filtered;
+    Exposure reference;
+    double shown_from = 0;
+    double error_sum = 0;
+    double error_square_sum = 0;
+    int errors = 0;
+
+    for (int frame_index = 0; frame_index < (SIM_WINDOW_S + 1.0) * FRAME_RATE_FPS; frame_index++) {
+        double t = frame_index / (double) FRAME_RATE_FPS;
+        double wheel = wheel_angle_deg(t) * M_PI / 180;
+        double omega = wheel_rate_dps(t) * M_PI / 180;
+
+        /* Gravity turns against the wheel, the centripetal part points away from the axle along U. */
+        g_now_s = t;
+        gyro_data[WHEEL_ACCEL_AXIS_U] = 0;
+        gyro_data[WHEEL_ACCEL_AXIS_V] = 0;
+        gyro_data[WHEEL_GYRO_AXIS] = WHEEL_GYRO_SIGN * (wheel_rate_dps(t) + gyro_bias_dps + noise(rng));
+        accel_data[WHEEL_ACCEL_AXIS_U] = cos(-wheel) + omega * omega * 0.05 / 9.81 + 0.02 * noise(rng);
+        accel_data[WHEEL_ACCEL_AXIS_V] = sin(-wheel) + 0.02 * noise(rng);
+        accel_data[WHEEL_GYRO_AXIS] = 0;
+        wheel_phase_update(gyro_data, accel_data, sys_count(t));
+
+        for (int slot = 0; slot < LEDFilter_POV::SUBFRAMES; slot++) {
+            /* Slots after the first wake on the next kernel tick, plus 20 us to run. */
+            double render = slot == 0 ? t : floor((t + slot / (double) (FRAME_RATE_FPS * LEDFilter_POV::SUBFRAMES)) * 1000 + 1e-9) / 1000;
+            g_now_s = render + 20e-6;
+            pov.apply_filter(&frame);
+
+            double latch = g_now_s + SIM_ENCODE_S + SIM_TRANSFER_S + 20e-6 * noise(rng) + SIM_RESET_S;
+            render_column(ideal, (uint32_t) (int64_t) llround(fmod(wheel_angle_deg(latch), 360.0) / 360.0 * 4294967296.0));
+
+            filtered.add(shown, shown_from, latch);
+            reference.add(shown_ideal, shown_from, latch);
+            shown_from = latch;
+            memcpy(shown, pixels, sizeof(shown));
+            memcpy(shown_ideal, ideal, sizeof(shown_ideal));
+            g_latch_s = latch;
+
+            if (t > 5) {
+                double estimate = wheel_phase_at(sys_count(latch)) / 4294967296.0 * 360.0;
+                double error = fmod(estimate - fmod(wheel_angle_deg(latch), 360.0) + 540.0, 360.0) - 180.0;
+                error_sum += error;
+                error_square_sum += error * error;
+                errors++;
+            }
+        }
+    }
+
+    std::vector<uint8_t> image(2 * SIM_IMAGE_SIZE * SIM_IMAGE_SIZE * 3);
+    double diff_sum = 0;
+    int covered = 0;
+    for (int y = 0; y < SIM_IMAGE_SIZE; y++) {
+        for (int x = 0; x < SIM_IMAGE_SIZE; x++) {
+            int k = y * SIM_IMAGE_SIZE + x;
+            uint8_t *left = &image[3 * (2 * y * SIM_IMAGE_SIZE + x)];
+            uint8_t *right = left + 3 * SIM_IMAGE_SIZE;
+            for (int c = 0; c < 3; c++) {
+                left[c] = filtered.value(k, c);
+                right[c] = reference.value(k, c);
+            }
+            if (filtered.weight[k] > 0 || reference.weight[k] > 0) {
+                for (int c = 0; c < 3; c++) {
+                    diff_sum += abs(left[c] - right[c]);
+                }
+                covered++;
+            }
+        }
+    }
+
+    double bias = error_sum / errors;
+    double mean_diff = diff_sum / (3.0 * covered);
+    printf("wheel angle at the latch: bias %+.2f deg, sd %.2f deg\n", bias, sqrt(error_square_sum / errors - bias * bias));
+    printf("mean difference to the ideal image %.2f of 255 over %d pixels\n", mean_diff, covered);
+
+    if (png_write(path, image.data(), 2 * SIM_IMAGE_SIZE, SIM_IMAGE_SIZE) == -1) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 2;
+    }
+    printf("wrote %s\n", path);
+    return mean_diff <= SIM_MAX_MEAN_DIFF ? 0 : 1;
+}
@@ -0,0 +1,38 @@
+/*
+ * File: test_blend_dsp.cpp
+ * Description: Runs the DSP path of utils/blend_simd.h on the host, with the
+ * intrinsics of host_cmsis_dsp.h, and checks every blend mode against the byte by
+ * byte reference. The portable path is checked by bench_blend.
+ */
+
+#include <stdlib.h>
+#include "host_cmsis_dsp.h"
+#define BLEND_SIMD_DSP
+#include "blend_reference.h"
+#include "host_test.h"
+
+
+int main() {
+    static const BlendMode modes[] = {BLEND_MODE_ALPHA, BLEND_MODE_ADD, BLEND_MODE_MULTIPLY, BLEND_MODE_SCREEN};
+    srand(1);
+
+    for (BlendMode mode : modes) {
+        int mismatches = 0;
+
+        /* Every pair of byte values in every lane, at full weight. */
+        for (uint32_t x = 0; x < 256; x++) {
+            for (uint32_t y = 0; y < 256; y++) {
+                mismatches += reference_check_word(x * 0x01010101U, y * 0x01010101U, mode, 256);
+            }
+        }
+        for (uint32_t weight = 0; weight <= 256; weight++) {
+            for (int i = 0; i < 1000; i++) {
+                uint32_t dst = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+                uint32_t src = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+                mismatches += reference_check_word(dst, src, mode, weight);
+            }
+        }
+        CHECK(mismatches == 0, "mode %d: %d bytes differ from the reference", mode, mismatches);
+    }
+    return host_test_result();
+}
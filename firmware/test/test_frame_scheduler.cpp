@@ -0,0 +1,104 @@
+/*
+ * File: test_frame_scheduler.cpp
+ * Description: Slot pacing of frame_scheduler/frame_scheduler.h on a simulated 1 kHz
+ * kernel tick.
+ *
+ * The loop changes the slots per frame the way main.cpp does when the filter changes,
+ * from every slot of a frame in turn. The change must not add or move a render slot:
+ * renders stay one frame period apart, the frame that is running keeps its slots, and
+ * every frame after it has the new number of slots.
+ */
+
+#include <stdint.h>
+#include <vector>
+#include "frame_scheduler/frame_scheduler.h"
+#include "kernel.h"
+#include "globals.h"
+#include "host_test.h"
+
+#define SIM_TICK_HZ (1000)
+#define SIM_SYS_PER_TICK (39000)
+#define SIM_FRAMES (30)
+
+static uint32_t g_tick = 0;
+
+uint32_t osKernelGetTickCount(void) {
+    return g_tick;
+}
+
+uint32_t osKernelGetTickFreq(void) {
+    return SIM_TICK_HZ;
+}
+
+uint32_t osKernelGetSysTimerCount(void) {
+    return g_tick * SIM_SYS_PER_TICK;
+}
+
+uint32_t osKernelGetSysTimerFreq(void) {
+    return SIM_TICK_HZ * SIM_SYS_PER_TICK;
+}
+
+osStatus_t osDelayUntil(uint32_t ticks) {
+    g_tick = ticks;
+    return osOK;
+}
+
+void osKernelEnableIdleSleep(osIdleSleepEnterEvent_t enter_sleep_event, osIdleSleepExitEvent_t exit_sleep_event) {
+}
+
+
+/* Slots between each render and the next one, with the tick of each render. */
+struct frame_record {
+    uint32_t render_tick;
+    int slots;
+};
+
+
+/********************************************//**
+ *  Runs SIM_FRAMES frames at from slots per frame,
+ *  changes to to slots in slot change_slot of the
+ *  third frame and runs SIM_FRAMES more frames.
+ ***********************************************/
+static void test_change(int from, int to, int change_slot) {
+    frame_scheduler_set_subframes(from);
+    while (frame_scheduler_wait() != FRAME_SLOT_RENDER) {
+    }
+    frame_scheduler_restart();
+
+    std::vector<frame_record> frames;
+    for (int slot = 0; frames.size() < 2 * SIM_FRAMES; slot++) {
+        if (frame_scheduler_wait() == FRAME_SLOT_RENDER) {
+            frames.push_back({g_tick, 0});
+            slot = 0;
+        }
+        frames.back().slots++;
+
+        if (frames.size() == 3 && slot == change_slot) {
+            frame_scheduler_set_subframes(to);
+        }
+    }
+
+    uint32_t min_period = SIM_TICK_HZ / FRAME_RATE_FPS;
+    uint32_t max_period = (SIM_TICK_HZ + FRAME_RATE_FPS - 1) / FRAME_RATE_FPS;
+    for (size_t i = 0; i + 1 < frames.size(); i++) {
+        uint32_t period = frames[i + 1].render_tick - frames[i].render_tick;
+        int expected = i < 3 ? from : to;
+        CHECK(period >= min_period && period <= max_period,
+              "%d -> %d in slot %d: frame %zu lasted %lu ticks", from, to, change_slot, i, (unsigned long) period);
+        CHECK(frames[i].slots == expected,
+              "%d -> %d in slot %d: frame %zu had %d slots, expected %d", from, to, change_slot, i, frames[i].slots, expected);
+    }
+}
+
+
+int main() {
+    frame_scheduler_init(FRAME_RATE_FPS, 1);
+
+    static const int counts[][2] = {{1, 8}, {8, 1}, {8, 2}, {2, 8}, {4, 8}, {8, 4}, {3, 5}};
+    for (const auto &count : counts) {
+        for (int slot = 0; slot < count[0]; slot++) {
+            test_change(count[0], count[1], slot);
+        }
+    }
+    return host_test_result();
+}
@@ -0,0 +1,174 @@
+/*
+ * File: test_led_protocol.cpp
+ * Description: Golden frames of the strip backends, see ws2812b/led_protocol.h.
+ *
+ * Each backend assembles a frame of 1, 16 and 17 pixels the way led_strip_emit_group()
+ * does, whole groups with encode_group() and the rest with encode_pixel(). The frame is
+ * compared byte for byte with one built here from the datasheets: the one-wire symbols
+ * bit by bit, the APA102 frames field by field. A few pixels are also checked against
+ * literal bytes, so the bit builder cannot drift along with the encoders.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "ws2812b/led_protocol.h"
+#include "ws2812b/ws2812b_encoding.h"
+#include "host_test.h"
+
+static const int pixel_counts[] = {1, 16, 17};
+
+
+static void test_pixel(int index, uint8_t *red, uint8_t *green, uint8_t *blue) {
+    *red = (uint8_t) (index * 37 + 1);
+    *green = (uint8_t) (255 - index * 13);
+    *blue = (uint8_t) ((index * 29) ^ 0x5A);
+}
+
+
+/********************************************//**
+ *  Assembles a frame of num_pixels test pixels
+ *  with a backend. The buffer starts out filled
+ *  with 0xAA, so a header or trailer byte that
+ *  init_frame() misses shows up.
+ ***********************************************/
+static std::vector<uint8_t> encode_frame(const struct led_protocol *protocol, int num_pixels) {
+    std::vector<uint8_t> frame(protocol->header_bytes + protocol->bytes_per_pixel * num_pixels +
+                               protocol->trailer_bytes(num_pixels), 0xAA);
+    protocol->init_frame(frame.data(), num_pixels);
+
+    uint8_t *pixel_buf = frame.data() + protocol->header_bytes;
+    for (int first = 0; first < num_pixels; first += LED_PROTOCOL_GROUP_PIXELS) {
+        uint8_t group[LED_PROTOCOL_GROUP_PIXELS][3];
+        int count = std::min(LED_PROTOCOL_GROUP_PIXELS, num_pixels - first);
+        for (int i = 0; i < count; i++) {
+            test_pixel(first + i, &group[i][0], &group[i][1], &group[i][2]);
+        }
+
+        uint8_t *buf = pixel_buf + protocol->bytes_per_pixel * first;
+        if (count == LED_PROTOCOL_GROUP_PIXELS) {
+            protocol->encode_group(buf, group);
+        } else {
+            for (int i = 0; i < count; i++) {
+                protocol->encode_pixel(buf + protocol->bytes_per_pixel * i, group[i][0], group[i][1], group[i][2]);
+            }
+        }
+    }
+    return frame;
+}
+
+
+/* Appends a data byte as one-wire symbols of symbol_bits SPI bits, MSB first. */
+static void append_symbols(std::vector<bool> *bits, uint8_t value, int symbol_bits, int zero_high, int one_high) {
+    for (int bit = 7; bit >= 0; bit--) {
+        int high = (value >> bit) & 1 ? one_high : zero_high;
+        for (int i = 0; i < symbol_bits; i++) {
+            bits->push_back(i < high);
+        }
+    }
+}
+
+static std::vector<uint8_t> pack_bits(const std::vector<bool> &bits) {
+    std::vector<uint8_t> bytes((bits.size() + 7) / 8, 0);
+    for (size_t i = 0; i < bits.size(); i++) {
+        bytes[i / 8] |= (uint8_t) (bits[i] << (7 - i % 8));
+    }
+    return bytes;
+}
+
+
+static void check_frame(const char *name, int num_pixels, const std::vector<uint8_t> &frame,
+                        const std::vector<uint8_t> &expected) {
+    CHECK(frame.size() == expected.size(), "%s, %d pixels: %zu bytes, expected %zu",
+          name, num_pixels, frame.size(), expected.size());
+    if (frame.size() != expected.size()) {
+        return;
+    }
+    size_t mismatch = std::mismatch(frame.begin(), frame.end(), expected.begin()).first - frame.begin();
+    CHECK(mismatch == frame.size(), "%s, %d pixels: byte %zu is 0x%02X, expected 0x%02X",
+          name, num_pixels, mismatch, frame[mismatch], expected[mismatch]);
+}
+
+
+/* WS2812B takes green, red, blue. The symbols follow WS2812B_ENCODING. */
+static void test_ws2812b() {
+    const int symbol_bits = Ws2812bEncoder::BYTES_PER_CHANNEL;
+    const int one_high = symbol_bits == 3 ? 2 : 3;
+
+    CHECK(led_protocol_ws2812b.header_bytes == 0, "header of %d bytes", led_protocol_ws2812b.header_bytes);
+    for (int num_pixels : pixel_counts) {
+        std::vector<bool> bits;
+        for (int i = 0; i < num_pixels; i++) {
+            uint8_t red, green, blue;
+            test_pixel(i, &red, &green, &blue);
+            append_symbols(&bits, green, symbol_bits, 1, one_high);
+            append_symbols(&bits, red, symbol_bits, 1, one_high);
+            append_symbols(&bits, blue, symbol_bits, 1, one_high);
+        }
+        check_frame("ws2812b", num_pixels, encode_frame(&led_protocol_ws2812b, num_pixels), pack_bits(bits));
+    }
+
+    if (symbol_bits == 3) {
+        /* green 0xFF is 110 eight times, red 0x00 is 100, blue 0x80 is 110 then 100 */
+        static const uint8_t golden[9] = {0xDB, 0x6D, 0xB6, 0x92, 0x49, 0x24, 0xD2, 0x49, 0x24};
+        uint8_t pixel[9];
+        led_protocol_ws2812b.encode_pixel(pixel, 0x00, 0xFF, 0x80);
+        CHECK(memcmp(pixel, golden, sizeof(golden)) == 0, "ws2812b pixel 00 FF 80 does not match the golden bytes");
+    }
+}
+
+
+/* SK6812 RGBW takes green, red, blue, white, with the common part of the colour on white. */
+static void test_sk6812_rgbw() {
+    CHECK(led_protocol_sk6812_rgbw.header_bytes == 0, "header of %d bytes", led_protocol_sk6812_rgbw.header_bytes);
+    for (int num_pixels : pixel_counts) {
+        std::vector<bool> bits;
+        for (int i = 0; i < num_pixels; i++) {
+            uint8_t red, green, blue;
+            test_pixel(i, &red, &green, &blue);
+            uint8_t white = std::min(red, std::min(green, blue));
+            append_symbols(&bits, (uint8_t) (green - white), 4, 1, 2);
+            append_symbols(&bits, (uint8_t) (red - white), 4, 1, 2);
+            append_symbols(&bits, (uint8_t) (blue - white), 4, 1, 2);
+            append_symbols(&bits, white, 4, 1, 2);
+        }
+        check_frame("sk6812_rgbw", num_pixels, encode_frame(&led_protocol_sk6812_rgbw, num_pixels), pack_bits(bits));
+    }
+
+    /* 200 100 50 is white 50 plus 150 50 0, on the wire 0x32 0x96 0x00 0x32. A zero is
+     * 1000 and a one 1100, so 0x32 (00 11 00 10) is 88 CC 88 C8. */
+    static const uint8_t golden[16] = {0x88, 0xCC, 0x88, 0xC8, 0xC8, 0x8C, 0x8C, 0xC8,
+                                       0x88, 0x88, 0x88, 0x88, 0x88, 0xCC, 0x88, 0xC8};
+    uint8_t pixel[16];
+    led_protocol_sk6812_rgbw.encode_pixel(pixel, 200, 100, 50);
+    CHECK(memcmp(pixel, golden, sizeof(golden)) == 0, "sk6812_rgbw pixel 200 100 50 does not match the golden bytes");
+}
+
+
+/* APA102: a zero start frame, 0xFF blue green red per pixel and 4 + (n + 15) / 16 zero bytes. */
+static void test_apa102() {
+    static const int trailer_bytes[] = {5, 5, 6};
+
+    for (size_t t = 0; t < sizeof(pixel_counts) / sizeof(pixel_counts[0]); t++) {
+        int num_pixels = pixel_counts[t];
+        CHECK(led_protocol_apa102.trailer_bytes(num_pixels) == trailer_bytes[t], "%d pixels: trailer of %d bytes",
+              num_pixels, led_protocol_apa102.trailer_bytes(num_pixels));
+
+        std::vector<uint8_t> expected(4, 0x00);
+        for (int i = 0; i < num_pixels; i++) {
+            uint8_t red, green, blue;
+            test_pixel(i, &red, &green, &blue);
+            expected.insert(expected.end(), {0xFF, blue, green, red});
+        }
+        expected.insert(expected.end(), trailer_bytes[t], 0x00);
+        check_frame("apa102", num_pixels, encode_frame(&led_protocol_apa102, num_pixels), expected);
+    }
+}
+
+
+int main() {
+    test_ws2812b();
+    test_sk6812_rgbw();
+    test_apa102();
+    return host_test_result();
+}
@@ -0,0 +1,113 @@
+/*
+ * File: test_one_wire.cpp
+ * Description: Decodes what the one-wire encoders produce and checks it against the
+ * datasheet timing, see ws2812b/one_wire_decoder.h.
+ *
+ * Given a path, it also writes a short WS2812B stream there for the one_wire_decode
+ * test: red, green and blue, followed by the idle line.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "ws2812b/one_wire_decoder.h"
+#include "ws2812b/led_protocol.h"
+#include "globals.h"
+#include "host_test.h"
+
+#define MAX_BYTES_PER_PIXEL (16)
+
+
+/********************************************//**
+ *  Encodes one group of test pixels, decodes it
+ *  and compares it with the wire bytes the chip
+ *  should receive. Returns the pixels that failed.
+ ***********************************************/
+static int check_group(const struct led_protocol *protocol, uint32_t baudrate, const OneWireTiming &timing,
+                       const uint8_t (*pixels)[3], int channels) {
+    uint8_t stream[LED_PROTOCOL_GROUP_PIXELS * MAX_BYTES_PER_PIXEL];
+    uint8_t decoded[LED_PROTOCOL_GROUP_PIXELS * 4];
+    OneWireDecodeReport report;
+
+    protocol->encode_group(stream, pixels);
+    int bytes = one_wire_decode(stream, protocol->bytes_per_pixel * LED_PROTOCOL_GROUP_PIXELS, baudrate, timing,
+                                decoded, sizeof(decoded), &report);
+    if (bytes != channels * LED_PROTOCOL_GROUP_PIXELS || report.timing_violations > 0) {
+        return LED_PROTOCOL_GROUP_PIXELS;
+    }
+
+    int failed = 0;
+    for (int i = 0; i < LED_PROTOCOL_GROUP_PIXELS; i++) {
+        uint8_t white = channels == 4 ? std::min(pixels[i][0], std::min(pixels[i][1], pixels[i][2])) : 0;
+        const uint8_t wire[4] = {(uint8_t) (pixels[i][1] - white), (uint8_t) (pixels[i][0] - white),
+                                 (uint8_t) (pixels[i][2] - white), white};
+        if (memcmp(&decoded[channels * i], wire, channels) != 0) {
+            failed++;
+        }
+    }
+    return failed;
+}
+
+
+static void test_encoders() {
+    static_assert(Ws2812bEncoder::BYTES_PER_CHANNEL * 3 <= MAX_BYTES_PER_PIXEL, "test buffer too small");
+    static_assert(Sk6812Encoder::BYTES_PER_CHANNEL * 4 <= MAX_BYTES_PER_PIXEL, "test buffer too small");
+    int failed_ws2812b = 0;
+    int failed_sk6812 = 0;
+
+    /* Every value on every channel, with the other channels set so that neighbouring
+     * symbols cover all transitions. */
+    for (int value = 0; value < 256; value += LED_PROTOCOL_GROUP_PIXELS) {
+        uint8_t pixels[LED_PROTOCOL_GROUP_PIXELS][3];
+        for (int i = 0; i < LED_PROTOCOL_GROUP_PIXELS; i++) {
+            uint8_t v = (uint8_t) (value + i);
+            pixels[i][0] = v;
+            pixels[i][1] = (uint8_t) ~v;
+            pixels[i][2] = (uint8_t) (v ^ 0x5A);
+        }
+        failed_ws2812b += check_group(&led_protocol_ws2812b, SPI_BAUDRATE, WS2812B_TIMING, pixels, 3);
+        failed_sk6812 += check_group(&led_protocol_sk6812_rgbw, SK6812_SPI_BAUDRATE, SK6812_TIMING, pixels, 4);
+    }
+
+    CHECK(failed_ws2812b == 0, "%d WS2812B pixels failed", failed_ws2812b);
+    CHECK(failed_sk6812 == 0, "%d SK6812 pixels failed", failed_sk6812);
+}
+
+
+/* The decoder has to notice a high pulse that fits neither window. */
+static void test_violation() {
+    uint8_t stream[] = {0xFF, 0xFF, 0x00, 0x00};
+    uint8_t decoded[4];
+    OneWireDecodeReport report;
+
+    one_wire_decode(stream, sizeof(stream), SPI_BAUDRATE, WS2812B_TIMING, decoded, sizeof(decoded), &report);
+    CHECK(report.timing_violations == 1, "%d violations", report.timing_violations);
+    CHECK(report.first_violation_bit == 0, "first violation at bit %d", report.first_violation_bit);
+}
+
+
+static void write_sample(const char *path) {
+    static const uint8_t pixels[3][3] = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}};
+    uint8_t stream[3 * 3 * Ws2812bEncoder::BYTES_PER_CHANNEL + 8] = {0};
+
+    for (int i = 0; i < 3; i++) {
+        led_protocol_ws2812b.encode_pixel(stream + led_protocol_ws2812b.bytes_per_pixel * i,
+                                          pixels[i][0], pixels[i][1], pixels[i][2]);
+    }
+
+    FILE *file = fopen(path, "wb");
+    CHECK(file != NULL, "cannot write %s", path);
+    if (file != NULL) {
+        fwrite(stream, 1, sizeof(stream), file);
+        fclose(file);
+    }
+}
+
+
+int main(int argc, char **argv) {
+    test_encoders();
+    test_violation();
+    if (argc > 1) {
+        write_sample(argv[1]);
+    }
+    return host_test_result();
+}
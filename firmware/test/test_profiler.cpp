@@ -0,0 +1,70 @@
+/*
+ * File: test_profiler.cpp
+ * Description: The histograms of profiler/profiler.cpp and its clock_gettime()
+ * clock, built into this file so that a test can read the histograms.
+ *
+ * Every value falls into the bucket whose limits enclose it, so the p99 of a report
+ * is never below the real one and at most 25 % above it. A ProfileScope around a
+ * sleep records the sleep in ns.
+ */
+
+#include <time.h>
+#include "profiler/profiler.cpp"
+#include "host_test.h"
+
+
+static void test_buckets() {
+    int failures = 0;
+    uint32_t value = 0;
+    for (int step = 0; step < 100000 && failures < 10; step++) {
+        int bucket = profiler_bucket(value);
+        uint32_t limit = profiler_bucket_limit(bucket);
+        bool valid = bucket >= 0 && bucket < PROFILER_BUCKETS && limit >= value && (uint64_t) limit <= (uint64_t) value + value / 4 + 1 &&
+                     (bucket == 0 || profiler_bucket_limit(bucket - 1) < value);
+        CHECK(valid, "%lu falls into bucket %d up to %lu", (unsigned long) value, bucket, (unsigned long) limit);
+        failures += !valid;
+        if (value == UINT32_MAX) {
+            break;
+        }
+        value += value < 64 ? 1 : (uint32_t) std::min<uint64_t>(value / 37 + 1, UINT32_MAX - value);
+    }
+    CHECK(value == UINT32_MAX && profiler_bucket_limit(profiler_bucket(UINT32_MAX)) == UINT32_MAX,
+          "stopped at %lu", (unsigned long) value);
+}
+
+
+static void test_histogram() {
+    profiler_init();
+    for (uint32_t i = 1; i <= 1000; i++) {
+        profiler_record(PROFILE_STAGE_FILTER, i * 10);
+    }
+    struct profile_histogram *histogram = &g_profile[PROFILE_STAGE_FILTER];
+    CHECK(histogram->count == 1000 && histogram->min == 10 && histogram->max == 10000 && histogram->sum == 5005000,
+          "n=%lu min=%lu max=%lu sum=%llu", (unsigned long) histogram->count, (unsigned long) histogram->min,
+          (unsigned long) histogram->max, (unsigned long long) histogram->sum);
+
+    profiler_report();
+    CHECK(histogram->count == 0 && histogram->min == UINT32_MAX && histogram->sum == 0, "the report did not clear the histogram");
+}
+
+
+static void test_clock() {
+    profiler_init();
+    {
+        PROFILE_SCOPE(PROFILE_STAGE_SENSORS);
+        struct timespec sleep = {0, 2000000};
+        nanosleep(&sleep, NULL);
+    }
+    struct profile_histogram *histogram = &g_profile[PROFILE_STAGE_SENSORS];
+    CHECK(histogram->count == 1 && histogram->min >= 2000000 && histogram->min < 200000000,
+          "a 2 ms sleep took %lu " PROFILER_UNIT, (unsigned long) histogram->min);
+    profiler_report();
+}
+
+
+int main() {
+    test_buckets();
+    test_histogram();
+    test_clock();
+    return host_test_result();
+}
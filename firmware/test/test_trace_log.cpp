@@ -0,0 +1,225 @@
+/*
+ * File: test_trace_log.cpp
+ * Description: The ring and the formatter of trace_log/trace_log.cpp.
+ *
+ * The ColdwaveOS log output is captured here instead of host_logging.cpp, one line
+ * per entry. Entries come out as printf() formats them at the call site, in order
+ * across the wrap of the ring. A full ring drops and counts new entries and keeps
+ * the old ones. Producer threads writing at the same time as the reader lose no
+ * entry that was not counted as dropped, and duplicate or reorder none.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include "trace_log/trace_log.h"
+#include "kernel.h"
+#include "host_test.h"
+
+LOG_MODULE(test_trace_log)
+
+#define TEST_PRODUCERS (4)
+#define TEST_PRODUCER_ENTRIES (20000)
+
+static std::atomic<uint32_t> g_tick{0};
+static std::vector<std::string> g_lines;
+static std::string g_line;
+static std::atomic<uint32_t> g_formatted{0};   // lines output so far
+
+uint32_t osKernelGetTickCount(void) {
+    return g_tick.load(std::memory_order_relaxed);
+}
+
+osStatus_t osDelay(uint32_t ticks) {
+    return osOK;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+    return NULL;
+}
+
+void cw_log_output(const char *fmt, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    g_line += text;
+}
+
+void cw_log_prepare_formatting(int lvl) {
+}
+
+void cw_log_prefix(int lvl, const char *mod) {
+}
+
+void cw_log_cleanup(int nl) {
+    g_lines.push_back(g_line);
+    g_line.clear();
+    g_formatted++;
+}
+
+void cw_log_timestamp(void) {
+}
+
+
+static std::string printf_line(uint32_t tick, const char *fmt, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    return "@" + std::to_string(tick) + " " + text;
+}
+
+
+static void test_format() {
+    g_lines.clear();
+    std::vector<std::string> expected;
+
+#define FORMAT_CASE(...) do { TRACE_WARNING(__VA_ARGS__); expected.push_back(printf_line(g_tick, __VA_ARGS__)); g_tick++; } while (0)
+    FORMAT_CASE("no arguments");
+    FORMAT_CASE("%d %i %u %x", -42, 7, 4000000000U, 0xBEEFU);
+    FORMAT_CASE("%5d|%-5d|%05u|%#x", 12, -3, 9U, 255U);
+    FORMAT_CASE("%ld %lu %hd", -100000L, 100000UL, (short) -5);
+    FORMAT_CASE("%.2f %8.3f %e", 1.25, -0.5f, 2048.0);
+    FORMAT_CASE("%s stage, %c%%", "render", 'x');
+#undef FORMAT_CASE
+
+    TRACE_DEBUG("compiled out %d", 1);
+    trace_log_flush();
+    CHECK(g_lines.size() == expected.size(), "%zu lines, expected %zu", g_lines.size(), expected.size());
+    for (size_t i = 0; i < g_lines.size() && i < expected.size(); i++) {
+        CHECK(g_lines[i] == expected[i], "formatted \"%s\", printf gives \"%s\"", g_lines[i].c_str(), expected[i].c_str());
+    }
+}
+
+
+static void test_wrap() {
+    g_lines.clear();
+    int written = 0;
+    for (int batch = 0; batch < 7; batch++) {
+        for (int i = 0; i < TRACE_LOG_RING_ENTRIES - 29; i++) {
+            TRACE_WARNING("entry %d", written++);
+        }
+        trace_log_flush();
+    }
+
+    CHECK((int) g_lines.size() == written, "%zu lines, expected %d", g_lines.size(), written);
+    for (size_t i = 0; i < g_lines.size(); i++) {
+        int value = -1;
+        sscanf(g_lines[i].c_str(), "@%*u entry %d", &value);
+        CHECK(value == (int) i, "line %zu is \"%s\"", i, g_lines[i].c_str());
+    }
+}
+
+
+static void test_full() {
+    struct trace_log_stats before, after;
+    trace_log_get_stats(&before);
+
+    g_lines.clear();
+    for (int i = 0; i < TRACE_LOG_RING_ENTRIES + 10; i++) {
+        TRACE_WARNING("entry %d", i);
+    }
+    trace_log_get_stats(&after);
+    CHECK(after.written - before.written == TRACE_LOG_RING_ENTRIES, "%lu entries written, expected %d",
+          (unsigned long) (after.written - before.written), TRACE_LOG_RING_ENTRIES);
+    CHECK(after.dropped - before.dropped == 10, "%lu entries dropped, expected 10", (unsigned long) (after.dropped - before.dropped));
+
+    trace_log_flush();
+    trace_log_get_stats(&after);
+    CHECK(after.max_used == TRACE_LOG_RING_ENTRIES, "max used %lu, expected %d", (unsigned long) after.max_used, TRACE_LOG_RING_ENTRIES);
+    CHECK(g_lines.size() == TRACE_LOG_RING_ENTRIES + 1, "%zu lines, expected %d", g_lines.size(), TRACE_LOG_RING_ENTRIES + 1);
+    for (size_t i = 0; i < g_lines.size() && i < TRACE_LOG_RING_ENTRIES; i++) {
+        int value = -1;
+        sscanf(g_lines[i].c_str(), "@%*u entry %d", &value);
+        CHECK(value == (int) i, "line %zu is \"%s\", the oldest entries must be kept", i, g_lines[i].c_str());
+    }
+    CHECK(!g_lines.empty() && g_lines.back() == "10 trace log entries dropped, the ring is full.",
+          "no report of the dropped entries");
+
+    g_lines.clear();
+    TRACE_WARNING("entry %d", 0);
+    trace_log_flush();
+    CHECK(g_lines.size() == 1, "%zu lines after the ring was drained, expected 1", g_lines.size());
+}
+
+
+static void test_producers() {
+    struct trace_log_stats before, after;
+    trace_log_get_stats(&before);
+    g_lines.clear();
+    g_formatted = 0;
+
+    std::atomic<int> running{TEST_PRODUCERS};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < TEST_PRODUCERS; p++) {
+        producers.emplace_back([p, &running, &before] {
+            for (int i = 0; i < TEST_PRODUCER_ENTRIES; i++) {
+                TRACE_WARNING("producer %d entry %d", p, i);
+                g_tick++;
+
+                /* Keep the ring from running full, the producers are much faster than the reader. */
+                struct trace_log_stats stats;
+                trace_log_get_stats(&stats);
+                while (stats.written - before.written - g_formatted > TRACE_LOG_RING_ENTRIES - 2 * TEST_PRODUCERS) {
+                    std::this_thread::yield();
+                    trace_log_get_stats(&stats);
+                }
+            }
+            running--;
+        });
+    }
+    while (running > 0) {
+        trace_log_flush();
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    trace_log_flush();
+    trace_log_get_stats(&after);
+
+    int last[TEST_PRODUCERS];
+    int received[TEST_PRODUCERS] = {0};
+    for (int p = 0; p < TEST_PRODUCERS; p++) {
+        last[p] = -1;
+    }
+    int reports = 0;
+    for (const std::string &line : g_lines) {
+        int p = -1, i = -1;
+        if (sscanf(line.c_str(), "@%*u producer %d entry %d", &p, &i) != 2) {
+            reports++;
+            continue;
+        }
+        CHECK(p >= 0 && p < TEST_PRODUCERS && i > last[p], "\"%s\" after entry %d", line.c_str(), p >= 0 && p < TEST_PRODUCERS ? last[p] : -1);
+        if (p >= 0 && p < TEST_PRODUCERS) {
+            last[p] = i;
+            received[p]++;
+        }
+    }
+
+    uint32_t written = after.written - before.written;
+    uint32_t dropped = after.dropped - before.dropped;
+    int total = 0;
+    for (int p = 0; p < TEST_PRODUCERS; p++) {
+        total += received[p];
+    }
+    CHECK(written + dropped == TEST_PRODUCERS * TEST_PRODUCER_ENTRIES, "%lu written and %lu dropped of %d",
+          (unsigned long) written, (unsigned long) dropped, TEST_PRODUCERS * TEST_PRODUCER_ENTRIES);
+    CHECK(total == (int) written, "%d entries formatted, %lu written", total, (unsigned long) written);
+    CHECK((dropped == 0) == (reports == 0), "%lu entries dropped, %d reports", (unsigned long) dropped, reports);
+    printf("%d producers: %lu entries formatted, %lu dropped\n", TEST_PRODUCERS, (unsigned long) written, (unsigned long) dropped);
+}
+
+
+int main() {
+    test_format();
+    test_wrap();
+    test_full();
+    test_producers();
+    return host_test_result();
+}
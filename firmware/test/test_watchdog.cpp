@@ -0,0 +1,201 @@
+/*
+ * File: test_watchdog.cpp
+ * Description: The reboot-safe record and the reset cause handling of
+ * watchdog/watchdog.cpp, which is built into this file so that a test can reboot
+ * the module.
+ *
+ * The EMU registers and the watchdog driver are fakes, the kernel tick is set by the
+ * test. A reboot keeps the record and the reset cause and starts the module statics
+ * over, as on the chip. A stage is only blamed for a reset when the record is intact
+ * and the cause is WDOG1; a stage past its deadline is blamed over the one that ran
+ * when the chip reset, until a fed frame clears it.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "globals.h"
+
+/* The EMU registers of watchdog.cpp, the highest one is at 0x104. */
+static uint32_t g_fake_emu[0x108 / 4];
+#undef EMU_MEMORY_MAPPED_ADDRESS
+#define EMU_MEMORY_MAPPED_ADDRESS ((uintptr_t) g_fake_emu)
+#define FAKE_EMU_CMD (g_fake_emu[0x070 / 4])
+#define FAKE_EMU_RSTCAUSE (g_fake_emu[0x104 / 4])
+
+#include "watchdog/watchdog.cpp"
+#include "host_test.h"
+
+#define FAKE_RSTCAUSE_PIN (1UL << 0)
+
+static uint32_t g_tick = 0;
+static int g_feeds = 0;
+static bool g_enabled = false;
+static struct device g_wdt_device;
+static struct wdt_driver g_wdt_driver;
+
+uint32_t osKernelGetTickCount(void) {
+    return g_tick;
+}
+
+uint32_t osKernelGetTickFreq(void) {
+    return 1000;
+}
+
+static cw_driver_return_t fake_wdt_enable(struct device *dev) {
+    g_enabled = true;
+    return 0;
+}
+
+static cw_driver_return_t fake_wdt_disable(struct device *dev) {
+    g_enabled = false;
+    return 0;
+}
+
+static cw_driver_return_t fake_wdt_reset(struct device *dev) {
+    g_feeds++;
+    return 0;
+}
+
+int open(const char *device_name) {
+    g_wdt_driver.wdt_enable = fake_wdt_enable;
+    g_wdt_driver.wdt_disable = fake_wdt_disable;
+    g_wdt_driver.wdt_reset = fake_wdt_reset;
+    g_wdt_device.drv = &g_wdt_driver.drv;
+    return strcmp(device_name, "wdt1") == 0 ? 0 : -1;
+}
+
+struct device *device_for_handle(int hDev) {
+    return hDev == 0 ? &g_wdt_device : NULL;
+}
+
+
+/********************************************//**
+ *  Resets the chip with the given reset cause and
+ *  starts the module with the stage deadlines of
+ *  main.cpp. Returns the report of the new boot.
+ ***********************************************/
+static struct watchdog_report reboot(uint32_t cause) {
+    FAKE_EMU_RSTCAUSE |= cause;
+    FAKE_EMU_CMD = 0;
+    g_wdt_dev = -1;
+    g_registered = 0;
+    g_checked_in = 0;
+    g_overdue = false;
+    g_report = {0, WATCHDOG_STAGE_NONE, 0};
+    g_enabled = false;
+
+    CHECK(watchdog_init() == 0 && g_enabled, "watchdog_init() failed");
+    CHECK(FAKE_EMU_CMD == WATCHDOG_EMU_CMD_RSTCAUSECLR, "the reset cause was not cleared");
+    FAKE_EMU_RSTCAUSE = 0;
+    watchdog_register(WATCHDOG_STAGE_SENSORS, 5);
+    watchdog_register(WATCHDOG_STAGE_RENDER, 10);
+    watchdog_register(WATCHDOG_STAGE_OUTPUT, 5);
+
+    struct watchdog_report report;
+    watchdog_get_report(&report);
+    return report;
+}
+
+
+/* Runs the stages of a frame from the current tick, each taking the given number of ticks, then feeds. */
+static void run_frame(uint32_t sensors, uint32_t render, uint32_t output) {
+    const uint32_t durations[WATCHDOG_STAGE_MAX_VALUE] = {sensors, render, output};
+    for (int stage = 0; stage < WATCHDOG_STAGE_MAX_VALUE; stage++) {
+        watchdog_begin((WatchdogStage) stage);
+        g_tick += durations[stage];
+        watchdog_checkin((WatchdogStage) stage);
+        g_tick += 3;
+    }
+    watchdog_feed();
+}
+
+
+static void test_record() {
+    /* Garbage after a power on, even with a stale WDOG1 cause. */
+    memset(&g_retained, 0x5A, sizeof(g_retained));
+    struct watchdog_report report = reboot(WATCHDOG_EMU_RSTCAUSE_WDOG1);
+    CHECK(report.stalled_stage == WATCHDOG_STAGE_NONE && report.resets == 0,
+          "garbage record reported %s after %lu resets", watchdog_stage_name(report.stalled_stage), (unsigned long) report.resets);
+
+    /* Hung in the render stage. */
+    g_tick = 1000;
+    run_frame(1, 2, 1);
+    watchdog_begin(WATCHDOG_STAGE_RENDER);
+    uint32_t render_tick = g_tick;
+    report = reboot(WATCHDOG_EMU_RSTCAUSE_WDOG1);
+    CHECK(report.stalled_stage == WATCHDOG_STAGE_RENDER && report.stalled_tick == render_tick && report.resets == 1,
+          "reported %s at tick %lu after %lu resets, expected render at %lu after 1", watchdog_stage_name(report.stalled_stage),
+          (unsigned long) report.stalled_tick, (unsigned long) report.resets, (unsigned long) render_tick);
+
+    /* The reset button in the middle of a stage does not blame it. */
+    watchdog_begin(WATCHDOG_STAGE_SENSORS);
+    report = reboot(FAKE_RSTCAUSE_PIN);
+    CHECK(report.stalled_stage == WATCHDOG_STAGE_NONE && report.resets == 1,
+          "pin reset reported %s after %lu resets", watchdog_stage_name(report.stalled_stage), (unsigned long) report.resets);
+
+    /* One flipped bit in any field invalidates the record. */
+    const int fields = sizeof(g_retained) / sizeof(uint32_t);
+    for (int field = 0; field < fields; field++) {
+        watchdog_begin(WATCHDOG_STAGE_OUTPUT);
+        ((uint32_t *) &g_retained)[field] ^= 1U << (field * 5);
+        report = reboot(WATCHDOG_EMU_RSTCAUSE_WDOG1);
+        CHECK(report.stalled_stage == WATCHDOG_STAGE_NONE && report.resets == 0,
+              "record with field %d corrupted reported %s after %lu resets", field,
+              watchdog_stage_name(report.stalled_stage), (unsigned long) report.resets);
+    }
+}
+
+
+static void test_deadlines() {
+    reboot(FAKE_RSTCAUSE_PIN);
+
+    /* Deadlines count from watchdog_begin(), not from the previous check-in. */
+    g_tick = 2000;
+    int feeds = g_feeds;
+    watchdog_begin(WATCHDOG_STAGE_SENSORS);
+    watchdog_checkin(WATCHDOG_STAGE_SENSORS);
+    g_tick += 50;
+    watchdog_begin(WATCHDOG_STAGE_RENDER);
+    g_tick += 9;
+    watchdog_checkin(WATCHDOG_STAGE_RENDER);
+    watchdog_begin(WATCHDOG_STAGE_OUTPUT);
+    watchdog_checkin(WATCHDOG_STAGE_OUTPUT);
+    watchdog_feed();
+    CHECK(g_feeds == feeds + 1, "a frame with a gap between stages was not fed");
+
+    /* A slow render is blamed, not the sensor stage the chip reset in. */
+    run_frame(1, 20, 1);
+    CHECK(g_feeds == feeds + 1, "a frame with a late render was fed");
+    watchdog_begin(WATCHDOG_STAGE_SENSORS);
+    struct watchdog_report report = reboot(WATCHDOG_EMU_RSTCAUSE_WDOG1);
+    CHECK(report.stalled_stage == WATCHDOG_STAGE_RENDER, "blamed %s, expected render", watchdog_stage_name(report.stalled_stage));
+
+    /* A late frame followed by a fed one is forgotten. */
+    feeds = g_feeds;
+    run_frame(1, 20, 1);
+    run_frame(1, 2, 1);
+    CHECK(g_feeds == feeds + 1, "fed %d times, expected once", g_feeds - feeds);
+    watchdog_begin(WATCHDOG_STAGE_OUTPUT);
+    report = reboot(WATCHDOG_EMU_RSTCAUSE_WDOG1);
+    CHECK(report.stalled_stage == WATCHDOG_STAGE_OUTPUT, "blamed %s, expected output", watchdog_stage_name(report.stalled_stage));
+
+    /* A stage that has not checked in by the feed is already late. */
+    feeds = g_feeds;
+    run_frame(1, 2, 1);
+    watchdog_begin(WATCHDOG_STAGE_SENSORS);
+    uint32_t sensors_tick = g_tick;
+    g_tick += 8;
+    watchdog_feed();
+    CHECK(g_feeds == feeds + 1, "fed %d times with the sensor stage hanging, expected once", g_feeds - feeds);
+    report = reboot(WATCHDOG_EMU_RSTCAUSE_WDOG1);
+    CHECK(report.stalled_stage == WATCHDOG_STAGE_SENSORS && report.stalled_tick == sensors_tick,
+          "blamed %s at tick %lu, expected sensors at %lu", watchdog_stage_name(report.stalled_stage),
+          (unsigned long) report.stalled_tick, (unsigned long) sensors_tick);
+}
+
+
+int main() {
+    test_record();
+    test_deadlines();
+    return host_test_result();
+}